@@ -0,0 +1,59 @@
+#include "Bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// replaces the global allocation functions for the benchmark executable so that cases can
+// report heap allocations per operation; counting is a single relaxed increment
+namespace
+{
+	std::atomic<size_t> allocationCount = 0;
+
+	void* Allocate(size_t size)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		if (void* p = std::malloc(size ? size : 1)) {
+			return p;
+		}
+		throw std::bad_alloc{};
+	}
+	void* AllocateAligned(size_t size, std::align_val_t alignment)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		if (void* p = _aligned_malloc(size ? size : 1, size_t(alignment))) {
+			return p;
+		}
+		throw std::bad_alloc{};
+	}
+}
+
+namespace chil::bench
+{
+	size_t GetAllocationCount()
+	{
+		return allocationCount.load(std::memory_order_relaxed);
+	}
+}
+
+void* operator new(size_t size) { return Allocate(size); }
+void* operator new[](size_t size) { return Allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	try { return Allocate(size); }
+	catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	try { return Allocate(size); }
+	catch (...) { return nullptr; }
+}
+void* operator new(size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { _aligned_free(p); }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "Bench.h"
+
+namespace chil::bench
+{
+	size_t Timer::GetOperations() const
+	{
+		return operations_;
+	}
+	size_t Timer::GetThreadCount() const
+	{
+		return threadCount_;
+	}
+	double Timer::GetNanosPerOperation() const
+	{
+		if (operations_ == 0) {
+			return 0.;
+		}
+		return std::chrono::duration<double, std::nano>(elapsed_).count() / double(operations_);
+	}
+	double Timer::GetOperationsPerSecond() const
+	{
+		const auto seconds = std::chrono::duration<double>(elapsed_).count();
+		return seconds > 0. ? double(operations_) / seconds : 0.;
+	}
+	double Timer::GetLatencyNanos(double quantile) const
+	{
+		if (latencies_.empty()) {
+			return 0.;
+		}
+		auto sorted = latencies_;
+		const auto rank = std::min(size_t(quantile * double(sorted.size())), sorted.size() - 1);
+		std::ranges::nth_element(sorted, sorted.begin() + rank);
+		return std::chrono::duration<double, std::nano>(sorted[rank]).count();
+	}
+	bool Timer::HasLatencies() const
+	{
+		return !latencies_.empty();
+	}
+	double Timer::GetAllocationsPerOperation() const
+	{
+		if (operations_ == 0) {
+			return 0.;
+		}
+		return double(allocations_) / double(operations_);
+	}
+	void Timer::AddRate(std::string name, double amount)
+	{
+		rates_.emplace_back(std::move(name), amount);
+	}
+	std::vector<std::pair<std::string, double>> Timer::GetRates() const
+	{
+		const auto seconds = std::chrono::duration<double>(elapsed_).count();
+		auto rates = rates_;
+		for (auto& r : rates) {
+			r.second = seconds > 0. ? r.second / seconds : 0.;
+		}
+		return rates;
+	}
+
+	std::vector<Case>& GetCases()
+	{
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	Registrar::Registrar(std::string name, std::function<void(Timer&)> body)
+	{
+		GetCases().push_back({ std::move(name), std::move(body) });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <latch>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Core/src/utl/Macro.h>
+
+namespace chil::bench
+{
+	// number of heap allocations made by the process so far (see Alloc.cpp)
+	size_t GetAllocationCount();
+
+	// handed to each benchmark body; only the work inside Measure() is timed, so setup
+	// and teardown (flushing async channels, etc.) can happen around it
+	class Timer
+	{
+	public:
+		template<std::invocable F>
+		void Measure(size_t operations, F&& batch)
+		{
+			const auto allocations = GetAllocationCount();
+			const auto start = std::chrono::steady_clock::now();
+			batch();
+			elapsed_ += std::chrono::steady_clock::now() - start;
+			allocations_ += GetAllocationCount() - allocations;
+			operations_ += operations;
+		}
+		// times every call on its own, on threadCount producer threads released together;
+		// op(i) makes the i-th call of its thread. the clock reads around each call are
+		// included in both the latencies and the throughput
+		template<std::invocable<size_t> F>
+		void MeasureCalls(size_t threadCount, size_t callsPerThread, F&& op)
+		{
+			using Clock = std::chrono::steady_clock;
+			threadCount = std::max<size_t>(threadCount, 1);
+			// sized up front so that recording does not allocate inside the measurement
+			std::vector<std::vector<Clock::duration>> latencies(threadCount, std::vector<Clock::duration>(callsPerThread));
+			const auto run = [&](std::vector<Clock::duration>& out) {
+				for (size_t i = 0; i < callsPerThread; i++) {
+					const auto start = Clock::now();
+					op(i);
+					out[i] = Clock::now() - start;
+				}
+			};
+			if (threadCount == 1) {
+				Measure(callsPerThread, [&] { run(latencies[0]); });
+			}
+			else {
+				// threads are created outside the measurement and released together
+				std::latch ready{ std::ptrdiff_t(threadCount) + 1 };
+				std::latch go{ 1 };
+				std::latch done{ std::ptrdiff_t(threadCount) };
+				std::vector<std::jthread> threads;
+				for (auto& out : latencies) {
+					threads.emplace_back([&] {
+						ready.count_down();
+						go.wait();
+						run(out);
+						done.count_down();
+					});
+				}
+				ready.arrive_and_wait();
+				Measure(callsPerThread * threadCount, [&] {
+					go.count_down();
+					done.wait();
+				});
+			}
+			for (auto& out : latencies) {
+				latencies_.insert(latencies_.end(), out.begin(), out.end());
+			}
+			threadCount_ = std::max(threadCount_, threadCount);
+		}
+		size_t GetOperations() const;
+		size_t GetThreadCount() const;
+		double GetNanosPerOperation() const;
+		double GetOperationsPerSecond() const;
+		// latency under which the given fraction of calls timed by MeasureCalls completed
+		// (e.g. .99); 0 when no calls were timed individually
+		double GetLatencyNanos(double quantile) const;
+		bool HasLatencies() const;
+		// counts allocations from every thread, so background work overlapping the
+		// measured batch is included
+		double GetAllocationsPerOperation() const;
+		// extra quantity reported per second of measured time (e.g. file syncs)
+		void AddRate(std::string name, double amount);
+		std::vector<std::pair<std::string, double>> GetRates() const;
+	private:
+		size_t operations_ = 0;
+		size_t allocations_ = 0;
+		size_t threadCount_ = 1;
+		std::chrono::steady_clock::duration elapsed_{};
+		std::vector<std::chrono::steady_clock::duration> latencies_;
+		std::vector<std::pair<std::string, double>> rates_;
+	};
+
+	struct Case
+	{
+		std::string name;
+		std::function<void(Timer&)> body;
+	};
+
+	std::vector<Case>& GetCases();
+
+	struct Registrar
+	{
+		Registrar(std::string name, std::function<void(Timer&)> body);
+	};
+}
+
+#define ZC_BENCH(group, name) \
+	static void ZC_CAT(ZZ_BENCH_, ZC_CAT(group, ZC_CAT(_, name)))(chil::bench::Timer&); \
+	static chil::bench::Registrar ZC_CAT(ZZ_BENCH_REG_, ZC_CAT(group, ZC_CAT(_, name))){ \
+		ZC_STR(group) "/" ZC_STR(name), &ZC_CAT(ZZ_BENCH_, ZC_CAT(group, ZC_CAT(_, name))) }; \
+	static void ZC_CAT(ZZ_BENCH_, ZC_CAT(group, ZC_CAT(_, name)))(chil::bench::Timer& timer)
\ No newline at end of file
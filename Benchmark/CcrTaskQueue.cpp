@@ -0,0 +1,92 @@
+#include "Bench.h"
+#include <Core/src/ccr/BoundedTaskQueue.h>
+#include <Core/src/ccr/GenericTaskQueue.h>
+#include <format>
+
+using namespace chil;
+
+// contention between the mutex-and-deque queue and the lock-free one: every thread pushes a
+// trivial task and then pops and runs one, so all threads are producers and consumers at
+// once and the queue is never popped empty (each pop follows a push made by its own thread)
+namespace
+{
+	constexpr size_t callCount = 200'000;
+	constexpr size_t boundedCapacity = 1024;
+
+	template<class Q>
+	void Run(bench::Timer& timer, Q& queue, size_t threadCount)
+	{
+		int sink = 0;
+		timer.MeasureCalls(threadCount, callCount / threadCount, [&](size_t i) {
+			queue.Push([&sink, i] { std::atomic_ref{ sink }.fetch_add(int(i), std::memory_order_relaxed); });
+			queue.PopExecute();
+		});
+	}
+
+	// single-threaded push followed by execute, the pattern of per-frame micro-tasks; a warm-up
+	// round grows the ring and fills the promise pool first, so that the measured rounds
+	// show the steady state (zero allocations per operation)
+	constexpr size_t pushExecuteCount = 1'000'000;
+	constexpr size_t drainBatch = 64;
+
+	template<class F>
+	void RunPushExecute(bench::Timer& timer, F&& round)
+	{
+		round(drainBatch);
+		timer.Measure(pushExecuteCount, [&] {
+			for (size_t i = 0; i < pushExecuteCount; i += drainBatch) {
+				round(i);
+			}
+		});
+	}
+
+	ZC_BENCH(CcrTaskQueue, PushExecuteDetached)
+	{
+		ccr::GenericTaskQueue queue;
+		int sink = 0;
+		RunPushExecute(timer, [&](size_t base) {
+			for (size_t i = base; i < base + drainBatch; i++) {
+				queue.PushDetached([&sink, i] { sink += int(i); });
+				queue.PopExecute();
+			}
+		});
+	}
+	ZC_BENCH(CcrTaskQueue, PushExecuteFuture)
+	{
+		ccr::GenericTaskQueue queue;
+		int sink = 0;
+		RunPushExecute(timer, [&](size_t base) {
+			for (size_t i = base; i < base + drainBatch; i++) {
+				auto future = queue.Push([&sink, i] { return sink += int(i); });
+				queue.PopExecute();
+				future.get();
+			}
+		});
+	}
+	// a burst of pushes run by a single drain
+	ZC_BENCH(CcrTaskQueue, PushDrainDetached)
+	{
+		ccr::GenericTaskQueue queue;
+		int sink = 0;
+		RunPushExecute(timer, [&](size_t base) {
+			for (size_t i = base; i < base + drainBatch; i++) {
+				queue.PushDetached([&sink, i] { sink += int(i); });
+			}
+			queue.DrainExecute();
+		});
+	}
+
+	const bool registered = [] {
+		for (size_t threadCount : { 1, 2, 4, 8, 16, 32 }) {
+			bench::Registrar{ std::format("CcrTaskQueue/Mutex/PushPop/x{}", threadCount), [threadCount](bench::Timer& timer) {
+				ccr::GenericTaskQueue queue;
+				Run(timer, queue, threadCount);
+			} };
+			bench::Registrar{ std::format("CcrTaskQueue/LockFree/PushPop/x{}", threadCount), [threadCount](bench::Timer& timer) {
+				ccr::BoundedTaskQueue queue{ boundedCapacity };
+				Run(timer, queue, threadCount);
+			} };
+		}
+		return true;
+	}();
+}
\ No newline at end of file
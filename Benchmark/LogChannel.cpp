@@ -0,0 +1,74 @@
+#include "Bench.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/AsyncChannel.h>
+#include <Core/src/log/Driver.h>
+#include <Core/src/log/SimpleFileDriver.h>
+#include <Core/src/log/TextFormatter.h>
+#include <filesystem>
+
+using namespace chil;
+
+// a function-local static site per call, as Log.h's chilog has, so that producers do not
+// serialize on the InternSite lookup
+#define chilog log::EntryBuilder{ ZZ_LOG_SITE_(log::Level::Error) }
+
+namespace
+{
+	class NullDriver : public log::IDriver
+	{
+	public:
+		void Submit(const log::Entry&) override {}
+		void Flush() override {}
+	};
+
+	std::shared_ptr<log::IDriver> MakeFileDriver()
+	{
+		return std::make_shared<log::SimpleFileDriver>(
+			std::filesystem::temp_directory_path() / "chil-bench" / "log.txt",
+			std::make_shared<log::TextFormatter>()
+		);
+	}
+
+	// bursts are kept below the ring capacity so that the async cases measure the
+	// producer-side cost rather than the rate at which the kernel thread drains
+	constexpr size_t burstSize = 10'000;
+	constexpr size_t burstCount = 20;
+	constexpr size_t ringCapacity = 1 << 14;
+
+	void RunBursts(bench::Timer& timer, log::IChannel& chan)
+	{
+		for (size_t b = 0; b < burstCount; b++) {
+			timer.Measure(burstSize, [&] {
+				for (size_t i = 0; i < burstSize; i++) {
+					chilog.info(L"frame update").chan(&chan);
+				}
+			});
+			chan.Flush();
+		}
+	}
+}
+
+ZC_BENCH(LogChannel, SyncNullDriver)
+{
+	log::Channel chan{ { std::make_shared<NullDriver>() } };
+	RunBursts(timer, chan);
+}
+
+ZC_BENCH(LogChannel, SyncFileDriver)
+{
+	log::Channel chan{ { MakeFileDriver() } };
+	RunBursts(timer, chan);
+}
+
+ZC_BENCH(LogChannel, AsyncNullDriver)
+{
+	log::AsyncChannel chan{ { std::make_shared<NullDriver>() }, ringCapacity };
+	RunBursts(timer, chan);
+}
+
+ZC_BENCH(LogChannel, AsyncFileDriver)
+{
+	log::AsyncChannel chan{ { MakeFileDriver() }, ringCapacity };
+	RunBursts(timer, chan);
+}
\ No newline at end of file
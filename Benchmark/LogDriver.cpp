@@ -0,0 +1,97 @@
+#include "Bench.h"
+#include <Core/src/log/Entry.h>
+#include <Core/src/log/SimpleFileDriver.h>
+#include <Core/src/log/BinaryFileDriver.h>
+#include <Core/src/log/BufferedFileDriver.h>
+#include <Core/src/log/CompressedFileDriver.h>
+#include <Core/src/log/TextFormatter.h>
+#include <filesystem>
+
+using namespace chil;
+
+namespace
+{
+	constexpr size_t entryCount = 200'000;
+
+	std::filesystem::path MakePath(const char* name)
+	{
+		auto path = std::filesystem::temp_directory_path() / "chil-bench" / name;
+		std::filesystem::remove(path);
+		return path;
+	}
+
+	log::Entry MakeEntry()
+	{
+		static const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+		return log::Entry{
+			.level_ = log::Level::Info,
+			.note_ = L"frame update finished for render target",
+			.pSite_ = &site,
+			.timestamp_ = log::Clock::now(),
+		};
+	}
+
+	void RunDriver(bench::Timer& timer, log::IDriver& driver, const log::Entry& e, size_t count = entryCount)
+	{
+		timer.Measure(count, [&] {
+			for (size_t i = 0; i < count; i++) {
+				driver.Submit(e);
+			}
+			driver.Flush();
+		});
+		timer.AddRate("entries", double(count));
+	}
+
+	void RunBuffered(bench::Timer& timer, log::BufferedFileDriver::Durability durability, size_t count = entryCount)
+	{
+		log::BufferedFileDriver driver{ MakePath("buffered.txt"), std::make_shared<log::TextFormatter>(), durability };
+		RunDriver(timer, driver, MakeEntry(), count);
+		timer.AddRate("syncs", double(driver.GetStats().syncs));
+	}
+}
+
+// same entry through each file driver, measured directly without a channel
+ZC_BENCH(LogDriver, SimpleFile)
+{
+	log::SimpleFileDriver driver{ MakePath("simple.txt"), std::make_shared<log::TextFormatter>() };
+	RunDriver(timer, driver, MakeEntry());
+	// the stream is flushed to the OS but never synced to disk
+	timer.AddRate("syncs", 0.);
+}
+
+// group commit with the default rules: sync per 64KiB or 200ms
+ZC_BENCH(LogDriver, BufferedFileGroupCommit)
+{
+	RunBuffered(timer, {});
+}
+
+// size/time commits without syncing, comparable to SimpleFile's durability
+ZC_BENCH(LogDriver, BufferedFileNoSync)
+{
+	RunBuffered(timer, { .syncData = false });
+}
+
+// every entry committed and synced on its own; fewer entries since each costs a disk flush
+ZC_BENCH(LogDriver, BufferedFileSyncEach)
+{
+	RunBuffered(timer, { .syncLevel = log::Level::Verbose }, 2'000);
+}
+
+ZC_BENCH(LogDriver, BinaryFile)
+{
+	log::BinaryFileDriver driver{ MakePath("binary.bin") };
+	RunDriver(timer, driver, MakeEntry());
+}
+
+// block compression on the background thread; the byte rates compare text produced with
+// what reaches the disk
+ZC_BENCH(LogDriver, CompressedFile)
+{
+	const auto path = MakePath("compressed.lz");
+	std::filesystem::remove(log::CompressedFileDriver::GetIndexPath(path));
+	log::CompressedFileDriver driver{ path, std::make_shared<log::TextFormatter>() };
+	RunDriver(timer, driver, MakeEntry());
+	const auto stats = driver.GetStats();
+	timer.AddRate("textBytes", double(stats.rawBytes));
+	timer.AddRate("diskBytes", double(stats.compressedBytes));
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "Bench.h"
+#include <Core/src/log/Entry.h>
+#include <Core/src/log/TextFormatter.h>
+#include <Core/src/log/JsonLinesDriver.h>
+
+using namespace chil;
+
+namespace
+{
+	constexpr size_t entryCount = 100'000;
+
+	// timestamps advance 10us per entry, so the cached second prefix is reused ~100k times
+	// per rebuild, roughly like a busy logger
+	log::Entry MakeEntry()
+	{
+		static const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+		log::Entry e{
+			.level_ = log::Level::Info,
+			.pSite_ = &site,
+			.timestamp_ = log::Clock::now(),
+		};
+		e.deferredNote_.emplace(L"frame {} took {:.2f}ms", 1024, 16.6);
+		return e;
+	}
+}
+
+// steady state: one reused buffer, should report zero allocations per entry
+ZC_BENCH(LogFormatter, FormatToReusedBuffer)
+{
+	const log::TextFormatter formatter;
+	auto e = MakeEntry();
+	std::wstring buffer;
+	formatter.FormatTo(buffer, e);
+	timer.Measure(entryCount, [&] {
+		for (size_t i = 0; i < entryCount; i++) {
+			e.timestamp_ += std::chrono::microseconds{ 10 };
+			buffer.clear();
+			formatter.FormatTo(buffer, e);
+		}
+	});
+}
+
+// UTF-8 output for byte-oriented drivers, without a wide intermediate
+ZC_BENCH(LogFormatter, FormatUtf8ToReusedBuffer)
+{
+	const log::TextFormatter formatter;
+	auto e = MakeEntry();
+	std::string buffer;
+	formatter.FormatUtf8To(buffer, e);
+	timer.Measure(entryCount, [&] {
+		for (size_t i = 0; i < entryCount; i++) {
+			e.timestamp_ += std::chrono::microseconds{ 10 };
+			buffer.clear();
+			formatter.FormatUtf8To(buffer, e);
+		}
+	});
+}
+
+// returning a fresh string per entry, as drivers did before FormatTo
+ZC_BENCH(LogFormatter, FormatNewString)
+{
+	const log::TextFormatter formatter;
+	auto e = MakeEntry();
+	timer.Measure(entryCount, [&] {
+		for (size_t i = 0; i < entryCount; i++) {
+			e.timestamp_ += std::chrono::microseconds{ 10 };
+			const auto text = formatter.Format(e);
+		}
+	});
+}
+
+// JSON line with structured fields into a reused byte buffer; should report zero allocations
+ZC_BENCH(LogFormatter, JsonLinesWithFields)
+{
+	auto e = MakeEntry();
+	e.fields_.emplace();
+	e.fields_->Add(L"bytes", 1 << 20);
+	e.fields_->Add(L"ms", 3.25);
+	e.fields_->Add(L"path", L"textures/stone.dds");
+	std::string buffer;
+	log::JsonLinesDriver::FormatTo(buffer, e);
+	timer.Measure(entryCount, [&] {
+		for (size_t i = 0; i < entryCount; i++) {
+			e.timestamp_ += std::chrono::microseconds{ 10 };
+			buffer.clear();
+			log::JsonLinesDriver::FormatTo(buffer, e);
+		}
+	});
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "Bench.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/AsyncChannel.h>
+#include <Core/src/log/Driver.h>
+#include <Core/src/log/SeverityLevelPolicy.h>
+#include <Core/src/log/SimpleFileDriver.h>
+#include <Core/src/log/StagedChannel.h>
+#include <Core/src/log/TextFormatter.h>
+#include <filesystem>
+#include <format>
+#include <mutex>
+
+using namespace chil;
+
+// a function-local static site per call, as Log.h's chilog has, so that producers do not
+// serialize on the InternSite lookup
+#define chilog log::EntryBuilder{ ZZ_LOG_SITE_(log::Level::Error) }
+
+// every combination of channel, policy, driver, stack-trace capture and producer count,
+// with each call timed for latency percentiles; run "Benchmark LogMatrix/Async" etc. to
+// pick a slice
+namespace
+{
+	class NullDriver : public log::IDriver
+	{
+	public:
+		void Submit(const log::Entry&) override {}
+		void Flush() override {}
+	};
+
+	// keeps a copy of the last entry, as the unit test mock does
+	class MockDriver : public log::IDriver
+	{
+	public:
+		void Submit(const log::Entry& e) override
+		{
+			std::lock_guard lck{ mtx_ };
+			entry_ = e;
+		}
+		void Flush() override {}
+	private:
+		std::mutex mtx_;
+		log::Entry entry_;
+	};
+
+	enum class ChannelKind { Sync, Async, Staged };
+	enum class PolicyKind { None, Severity };
+	enum class DriverKind { Null, Mock, File };
+
+	struct Config
+	{
+		ChannelKind channel;
+		PolicyKind policy;
+		DriverKind driver;
+		bool trace;
+		size_t threadCount;
+	};
+
+	// bursts stay below the ring capacity so that the async cases measure the producer-side
+	// cost; trace capture is orders of magnitude slower, so it gets fewer calls
+	constexpr size_t burstSize = 8'000;
+	constexpr size_t burstCount = 10;
+	constexpr size_t traceBurstSize = 400;
+	constexpr size_t ringCapacity = 1 << 14;
+	constexpr size_t producerCount = 4;
+
+	std::shared_ptr<log::IDriver> MakeDriver(DriverKind kind)
+	{
+		switch (kind) {
+		case DriverKind::Mock: return std::make_shared<MockDriver>();
+		case DriverKind::File: return std::make_shared<log::SimpleFileDriver>(
+			std::filesystem::temp_directory_path() / "chil-bench" / "matrix.txt",
+			std::make_shared<log::TextFormatter>()
+		);
+		default: return std::make_shared<NullDriver>();
+		}
+	}
+
+	void Run(bench::Timer& timer, const Config& config)
+	{
+		std::unique_ptr<log::IChannel> pChan;
+		if (config.channel == ChannelKind::Async) {
+			pChan = std::make_unique<log::AsyncChannel>(std::vector{ MakeDriver(config.driver) }, ringCapacity);
+		}
+		else if (config.channel == ChannelKind::Staged) {
+			pChan = std::make_unique<log::StagedChannel>(std::vector{ MakeDriver(config.driver) },
+				log::StagedChannel::Staging{ .capacity = ringCapacity });
+		}
+		else {
+			pChan = std::make_unique<log::Channel>(std::vector{ MakeDriver(config.driver) });
+		}
+		if (config.policy == PolicyKind::Severity) {
+			pChan->AttachPolicy(std::make_shared<log::SeverityLevelPolicy>(log::Level::Info));
+		}
+		const auto callsPerThread = (config.trace ? traceBurstSize : burstSize) / config.threadCount;
+		for (size_t b = 0; b < burstCount; b++) {
+			timer.MeasureCalls(config.threadCount, callsPerThread, [&](size_t) {
+				if (config.trace) {
+					chilog.info(L"frame update").trace().chan(pChan.get());
+				}
+				else {
+					chilog.info(L"frame update").no_trace().chan(pChan.get());
+				}
+			});
+			pChan->Flush();
+		}
+	}
+
+	std::string GetName(const Config& c)
+	{
+		constexpr const char* channels[] = { "Sync", "Async", "Staged" };
+		constexpr const char* policies[] = { "NoPolicy", "Severity" };
+		constexpr const char* drivers[] = { "Null", "Mock", "File" };
+		return std::format("LogMatrix/{}/{}/{}/{}/x{}", channels[int(c.channel)], policies[int(c.policy)],
+			drivers[int(c.driver)], c.trace ? "Trace" : "NoTrace", c.threadCount);
+	}
+
+	const bool registered = [] {
+		for (auto channel : { ChannelKind::Sync, ChannelKind::Async, ChannelKind::Staged }) {
+			for (auto policy : { PolicyKind::None, PolicyKind::Severity }) {
+				for (auto driver : { DriverKind::Null, DriverKind::Mock, DriverKind::File }) {
+					for (bool trace : { false, true }) {
+						for (size_t threadCount : { size_t(1), producerCount }) {
+							// SimpleFileDriver does not take concurrent Submits, so several
+							// producers writing to a file go through the other channels
+							if (channel == ChannelKind::Sync && driver == DriverKind::File && threadCount > 1) {
+								continue;
+							}
+							const Config config{ channel, policy, driver, trace, threadCount };
+							bench::Registrar{ GetName(config), [config](bench::Timer& timer) { Run(timer, config); } };
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}();
+}
\ No newline at end of file
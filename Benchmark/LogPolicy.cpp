@@ -0,0 +1,53 @@
+#include "Bench.h"
+#include <Core/src/log/Entry.h>
+#include <Core/src/log/RateLimitPolicy.h>
+#include <thread>
+#include <vector>
+
+using namespace chil;
+
+namespace
+{
+	constexpr size_t entryCount = 1'000'000;
+}
+
+// one flooding site, so nearly every entry is dropped; compare against the per-entry cost
+// of LogFormatter/FormatToReusedBuffer to see what suppression saves
+ZC_BENCH(LogPolicy, RateLimitFlood)
+{
+	static const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+	log::RateLimitPolicy policy;
+	log::Entry e{ .level_ = log::Level::Error, .pSite_ = &site, .timestamp_ = log::Clock::now() };
+	timer.Measure(entryCount, [&] {
+		for (size_t i = 0; i < entryCount; i++) {
+			e.timestamp_ += std::chrono::microseconds{ 1 };
+			policy.TransformFilter(e);
+		}
+	});
+	timer.AddRate("suppressed", double(policy.GetSuppressedCount()));
+}
+
+// threads flooding distinct sites through one policy, exercising the shared table
+ZC_BENCH(LogPolicy, RateLimitManySites)
+{
+	constexpr size_t threadCount = 4;
+	static const log::Site sites[threadCount] = {
+		{ __FILEW__, __FUNCTIONW__, __LINE__ },
+		{ __FILEW__, __FUNCTIONW__, __LINE__ },
+		{ __FILEW__, __FUNCTIONW__, __LINE__ },
+		{ __FILEW__, __FUNCTIONW__, __LINE__ },
+	};
+	log::RateLimitPolicy policy;
+	timer.Measure(entryCount * threadCount, [&] {
+		std::vector<std::jthread> threads;
+		for (size_t t = 0; t < threadCount; t++) {
+			threads.emplace_back([&, t] {
+				log::Entry e{ .level_ = log::Level::Error, .pSite_ = &sites[t], .timestamp_ = log::Clock::now() };
+				for (size_t i = 0; i < entryCount; i++) {
+					e.timestamp_ += std::chrono::microseconds{ 1 };
+					policy.TransformFilter(e);
+				}
+			});
+		}
+	});
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "Bench.h"
+#include <chrono>
+#include <iostream>
+#include <format>
+#include <fstream>
+
+using namespace chil;
+
+namespace
+{
+	std::string EscapeJson(std::string_view text)
+	{
+		std::string escaped;
+		for (const char c : text) {
+			if (c == '"' || c == '\\') {
+				escaped += '\\';
+			}
+			if ((unsigned char)c >= 0x20) {
+				escaped += c;
+			}
+		}
+		return escaped;
+	}
+
+	// one JSON object per line, so runs from successive commits can be appended to one file
+	// and compared by label and case name
+	void WriteResult(std::ostream& out, std::string_view label, std::string_view time,
+		const std::string& name, const bench::Timer& timer)
+	{
+		out << std::format(R"({{"label":"{}","time":"{}","case":"{}","threads":{},"ops":{},)"
+			R"("nsPerOp":{:.2f},"opsPerSec":{:.0f},"allocsPerOp":{:.4f})",
+			EscapeJson(label), time, EscapeJson(name), timer.GetThreadCount(), timer.GetOperations(),
+			timer.GetNanosPerOperation(), timer.GetOperationsPerSecond(), timer.GetAllocationsPerOperation());
+		if (timer.HasLatencies()) {
+			out << std::format(R"(,"p50Ns":{:.1f},"p99Ns":{:.1f},"p999Ns":{:.1f})",
+				timer.GetLatencyNanos(.5), timer.GetLatencyNanos(.99), timer.GetLatencyNanos(.999));
+		}
+		for (auto& [rateName, rate] : timer.GetRates()) {
+			out << std::format(R"(,"{}PerSec":{:.1f})", EscapeJson(rateName), rate);
+		}
+		out << "}\n";
+	}
+}
+
+// usage: Benchmark [filter] [--out <results.jsonl>] [--label <text>]
+// runs every registered case whose name contains filter (all cases if omitted); with --out,
+// results are also appended to the file as JSON lines tagged with the label (e.g. a commit id)
+int main(int argc, char** argv)
+{
+	std::string filter;
+	std::string outPath;
+	std::string label;
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		if (arg == "--out" && i + 1 < argc) {
+			outPath = argv[++i];
+		}
+		else if (arg == "--label" && i + 1 < argc) {
+			label = argv[++i];
+		}
+		else {
+			filter = arg;
+		}
+	}
+	std::ofstream results;
+	if (!outPath.empty()) {
+		results.open(outPath, std::ios::out | std::ios::app);
+		if (!results) {
+			std::cerr << "error: cannot open " << outPath << "\n";
+			return 1;
+		}
+	}
+	const auto time = std::format("{:%FT%TZ}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+	for (auto& c : bench::GetCases()) {
+		if (!filter.empty() && c.name.find(filter) == std::string::npos) {
+			continue;
+		}
+		bench::Timer timer;
+		c.body(timer);
+		std::cout << std::format("{:<48} {:>12.1f} ns/op {:>10.3f} allocs/op {:>12} ops",
+			c.name, timer.GetNanosPerOperation(), timer.GetAllocationsPerOperation(), timer.GetOperations());
+		if (timer.HasLatencies()) {
+			std::cout << std::format(" p50 {:>9.1f} p99 {:>9.1f} p999 {:>9.1f} ns",
+				timer.GetLatencyNanos(.5), timer.GetLatencyNanos(.99), timer.GetLatencyNanos(.999));
+		}
+		for (auto& [name, rate] : timer.GetRates()) {
+			std::cout << std::format(" {:>12.1f} {}/s", rate, name);
+		}
+		std::cout << "\n";
+		if (results.is_open()) {
+			WriteResult(results, label, time, c.name, timer);
+			results.flush();
+		}
+	}
+	return 0;
+}
\ No newline at end of file
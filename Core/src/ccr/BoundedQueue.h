@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <bit>
+#include <new>
+
+namespace chil::ccr
+{
+	// bounded lock-free queue after Dmitry Vyukov's design; each slot carries a sequence
+	// number that tells producers when it is free to write and consumers when it is ready
+	// to read, so threads only contend on the enqueue/dequeue cursors and never take a lock
+	template<typename T>
+	class BoundedQueue
+	{
+	public:
+		// capacity is rounded up to the next power of two
+		BoundedQueue(size_t capacity)
+			:
+			mask_{ std::bit_ceil(capacity < 2 ? size_t(2) : capacity) - 1 },
+			pSlots_{ std::make_unique<Slot[]>(mask_ + 1) }
+		{
+			for (size_t i = 0; i <= mask_; i++) {
+				pSlots_[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+		BoundedQueue(const BoundedQueue&) = delete;
+		BoundedQueue& operator=(const BoundedQueue&) = delete;
+		// returns false (leaving value untouched) if the queue is full
+		template<typename U>
+		bool TryPush(U&& value)
+		{
+			size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+			while (true) {
+				auto& slot = pSlots_[pos & mask_];
+				const size_t seq = slot.sequence.load(std::memory_order_acquire);
+				const auto diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+				if (diff == 0) {
+					if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						slot.value.emplace(std::forward<U>(value));
+						slot.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false;
+				}
+				else {
+					pos = enqueuePos_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+		// returns false (leaving out untouched) if the queue is empty
+		bool TryPop(T& out)
+		{
+			size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+			while (true) {
+				auto& slot = pSlots_[pos & mask_];
+				const size_t seq = slot.sequence.load(std::memory_order_acquire);
+				const auto diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+				if (diff == 0) {
+					if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						out = std::move(*slot.value);
+						slot.value.reset();
+						slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false;
+				}
+				else {
+					pos = dequeuePos_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+		// snapshot only; true if no push has claimed a slot that has not yet been popped
+		bool IsEmpty() const
+		{
+			return enqueuePos_.load(std::memory_order_acquire) == dequeuePos_.load(std::memory_order_acquire);
+		}
+		size_t GetCapacity() const
+		{
+			return mask_ + 1;
+		}
+	private:
+		// types
+		struct Slot
+		{
+			std::atomic<size_t> sequence;
+			std::optional<T> value;
+		};
+		// data
+		const size_t mask_;
+		std::unique_ptr<Slot[]> pSlots_;
+		alignas(std::hardware_destructive_interference_size) std::atomic<size_t> enqueuePos_ = 0;
+		alignas(std::hardware_destructive_interference_size) std::atomic<size_t> dequeuePos_ = 0;
+	};
+}
\ No newline at end of file
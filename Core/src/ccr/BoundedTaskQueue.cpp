@@ -0,0 +1,60 @@
+#include "BoundedTaskQueue.h"
+#include <thread>
+
+namespace chil::ccr
+{
+	BoundedTaskQueue::BoundedTaskQueue(size_t capacity)
+		:
+		tasks_{ capacity }
+	{}
+	void BoundedTaskQueue::PopExecute()
+	{
+		Task task;
+		for (int tries = 0; !tasks_.TryPop(task); tries++) {
+			if (tries < spinCount_) {
+				std::this_thread::yield();
+				continue;
+			}
+			const auto epoch = wakeEpoch_.load(std::memory_order_acquire);
+			sleeperCount_.fetch_add(1, std::memory_order_seq_cst);
+			if (tasks_.TryPop(task)) {
+				sleeperCount_.fetch_sub(1, std::memory_order_relaxed);
+				break;
+			}
+			wakeEpoch_.wait(epoch, std::memory_order_acquire);
+			sleeperCount_.fetch_sub(1, std::memory_order_relaxed);
+		}
+		// pairs with the sleeper registration in PushWrappedTask_: either the producer's last
+		// try sees the freed slot, or we see the producer as a sleeper and move the epoch
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (fullSleeperCount_.load(std::memory_order_relaxed) != 0) {
+			spaceEpoch_.fetch_add(1, std::memory_order_release);
+			spaceEpoch_.notify_one();
+		}
+		task();
+	}
+	void BoundedTaskQueue::PushWrappedTask_(Task task)
+	{
+		for (int tries = 0; !tasks_.TryPush(std::move(task)); tries++) {
+			if (tries < spinCount_) {
+				std::this_thread::yield();
+				continue;
+			}
+			const auto epoch = spaceEpoch_.load(std::memory_order_acquire);
+			fullSleeperCount_.fetch_add(1, std::memory_order_seq_cst);
+			if (tasks_.TryPush(std::move(task))) {
+				fullSleeperCount_.fetch_sub(1, std::memory_order_relaxed);
+				break;
+			}
+			spaceEpoch_.wait(epoch, std::memory_order_acquire);
+			fullSleeperCount_.fetch_sub(1, std::memory_order_relaxed);
+		}
+		// pairs with the sleeper registration in PopExecute: either the consumer's last try
+		// sees this task, or we see the consumer as a sleeper and move the epoch
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleeperCount_.load(std::memory_order_relaxed) != 0) {
+			wakeEpoch_.fetch_add(1, std::memory_order_release);
+			wakeEpoch_.notify_one();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include "BoundedQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <new>
+#include <functional>
+
+namespace chil::ccr
+{
+	// GenericTaskQueue's interface over a fixed-capacity lock-free ring (see BoundedQueue),
+	// for queues with many producers and consumers: a push or pop claims a slot with one CAS
+	// on a cursor instead of taking a mutex that every other pusher and popper waits on
+	//
+	// a pop from an empty queue spins briefly and then parks on an atomic wait, and being
+	// bounded, so does a push to a full queue until a consumer makes room. each side only
+	// wakes the other when someone is actually parked, so the common push and pop stay free
+	// of system calls
+	class BoundedTaskQueue
+	{
+		using Task = std::move_only_function<void()>;
+	public:
+		// capacity is rounded up to the next power of two
+		BoundedTaskQueue(size_t capacity = 1024);
+		template<std::invocable F>
+		auto Push(F&& function)
+		{
+			using T = std::invoke_result_t<F>;
+			std::packaged_task<T()> pkg{ std::forward<F>(function) };
+			auto future = pkg.get_future();
+			PushWrappedTask_([pkg = std::move(pkg)]() mutable { pkg(); });
+			return future;
+		}
+		// waits until there is a task to pop; a task can be briefly invisible to poppers
+		// after Push has claimed its slot, so this also covers a caller that knows a push has
+		// been made
+		void PopExecute();
+	private:
+		// functions
+		void PushWrappedTask_(Task task);
+		// data
+		// tries (yielding in between) before a consumer or producer parks
+		static constexpr int spinCount_ = 64;
+		BoundedQueue<Task> tasks_;
+		// parking, as in ThreadPool: a consumer reads the epoch, announces itself as a
+		// sleeper, tries once more and then waits for the epoch to change
+		alignas(std::hardware_destructive_interference_size) std::atomic<std::uint32_t> wakeEpoch_ = 0;
+		std::atomic<size_t> sleeperCount_ = 0;
+		// the same for producers waiting on a full queue, moved on by consumers
+		alignas(std::hardware_destructive_interference_size) std::atomic<std::uint32_t> spaceEpoch_ = 0;
+		std::atomic<size_t> fullSleeperCount_ = 0;
+	};
+}
\ No newline at end of file
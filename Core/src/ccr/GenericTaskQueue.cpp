@@ -1,20 +1,138 @@
 #include "GenericTaskQueue.h" 
+#include <utility> 
 
 namespace chil::ccr
 {
 	void GenericTaskQueue::PopExecute()
+	{
+		Task task;
+		{
+			std::unique_lock lck{ mtx_ };
+			waiterCount_++;
+			cv_.wait(lck, [this] { return !tasks_.IsEmpty(); });
+			waiterCount_--;
+			task = tasks_.Pop();
+		}
+		task();
+	}
+	bool GenericTaskQueue::TryPopExecute()
 	{
 		Task task;
 		{
 			std::lock_guard lck{ mtx_ };
-			task = std::move(tasks_.front());
-			tasks_.pop_front();
+			if (tasks_.IsEmpty()) {
+				return false;
+			}
+			task = tasks_.Pop();
+		}
+		task();
+		return true;
+	}
+	bool GenericTaskQueue::WaitPopExecute(std::chrono::steady_clock::duration timeout)
+	{
+		Task task;
+		{
+			std::unique_lock lck{ mtx_ };
+			waiterCount_++;
+			const bool popped = cv_.wait_for(lck, timeout, [this] { return !tasks_.IsEmpty(); });
+			waiterCount_--;
+			if (!popped) {
+				return false;
+			}
+			task = tasks_.Pop();
 		}
 		task();
+		return true;
+	}
+	size_t GenericTaskQueue::DrainExecute(size_t max)
+	{
+		// the batch is swapped with the queue's ring, leaving the queue with this thread's
+		// spare ring; the emptied batch becomes the spare afterwards, so the two rings trade
+		// places without either being reallocated. the spare is moved out first in case a
+		// task drains again on this thread
+		thread_local Ring spare;
+		Ring batch;
+		batch.Swap(spare);
+		{
+			std::lock_guard lck{ mtx_ };
+			if (tasks_.GetSize() <= max) {
+				batch.Swap(tasks_);
+			}
+			else {
+				for (size_t i = 0; i < max; i++) {
+					batch.Push(tasks_.Pop());
+				}
+			}
+		}
+		size_t count = 0;
+		try {
+			for (; !batch.IsEmpty(); count++) {
+				batch.Pop()();
+			}
+		}
+		catch (...) {
+			{
+				std::lock_guard lck{ mtx_ };
+				while (!tasks_.IsEmpty()) {
+					batch.Push(tasks_.Pop());
+				}
+				tasks_.Swap(batch);
+			}
+			cv_.notify_all();
+			throw;
+		}
+		spare.Swap(batch);
+		return count;
 	}
 	void GenericTaskQueue::PushWrappedTask_(Task task)
 	{
-		std::lock_guard lck{ mtx_ };
-		tasks_.push_back(std::move(task));
+		bool notify = false;
+		{
+			std::lock_guard lck{ mtx_ };
+			tasks_.Push(std::move(task));
+			notify = waiterCount_ != 0;
+		}
+		// skips the notification (a system call on some platforms) when no pop is waiting
+		if (notify) {
+			cv_.notify_one();
+		}
+	}
+
+	bool GenericTaskQueue::Ring::IsEmpty() const
+	{
+		return size_ == 0;
+	}
+	size_t GenericTaskQueue::Ring::GetSize() const
+	{
+		return size_;
+	}
+	void GenericTaskQueue::Ring::Push(Task task)
+	{
+		if (!pSlots_ || size_ > mask_) {
+			const auto capacity = pSlots_ ? (mask_ + 1) * 2 : size_t(16);
+			auto pGrown = std::make_unique<Task[]>(capacity);
+			for (size_t i = 0; i < size_; i++) {
+				pGrown[i] = std::move(pSlots_[(head_ + i) & mask_]);
+			}
+			pSlots_ = std::move(pGrown);
+			mask_ = capacity - 1;
+			head_ = 0;
+		}
+		pSlots_[(head_ + size_) & mask_] = std::move(task);
+		size_++;
+	}
+	GenericTaskQueue::Task GenericTaskQueue::Ring::Pop()
+	{
+		auto task = std::move(pSlots_[head_]);
+		head_ = (head_ + 1) & mask_;
+		size_--;
+		return task;
+	}
+	void GenericTaskQueue::Ring::Swap(Ring& other) noexcept
+	{
+		std::swap(pSlots_, other.pSlots_);
+		std::swap(mask_, other.mask_);
+		std::swap(head_, other.head_);
+		std::swap(size_, other.size_);
 	}
 }
\ No newline at end of file
@@ -1,29 +1,89 @@
 #pragma once 
-#include <deque> 
+#include "InlineTask.h" 
+#include "PoolAllocator.h" 
+#include <chrono> 
+#include <condition_variable> 
+#include <cstddef> 
+#include <exception> 
 #include <future> 
-#include <functional> 
+#include <limits> 
+#include <memory> 
+#include <mutex> 
 
 namespace chil::ccr
 {
+	// tasks are stored inline in a ring that keeps its capacity, and the promise behind each
+	// future comes from a BlockPool, so in the steady state neither pushing nor running a
+	// task allocates (as long as the callable fits in an InlineTask along with its promise)
 	class GenericTaskQueue
 	{
-		using Task = std::move_only_function<void()>;
+		using Task = InlineTask<>;
 	public:
 		template<std::invocable F>
 		auto Push(F&& function)
 		{
 			using T = std::invoke_result_t<F>;
-			std::packaged_task<T()> pkg{ std::forward<F>(function) };
-			auto future = pkg.get_future();
-			PushWrappedTask_([pkg = std::move(pkg)]() mutable { pkg(); });
+			// the allocator is rebound to the shared state type, so its own value type only
+			// has to be an object type (T can be a reference)
+			std::promise<T> promise{ std::allocator_arg, PoolAllocator<std::byte>{} };
+			auto future = promise.get_future();
+			PushWrappedTask_([promise = std::move(promise), function = std::forward<F>(function)]() mutable {
+				try {
+					if constexpr (std::is_void_v<T>) {
+						function();
+						promise.set_value();
+					}
+					else {
+						promise.set_value(function());
+					}
+				}
+				catch (...) {
+					promise.set_exception(std::current_exception());
+				}
+			});
 			return future;
 		}
+		// for tasks whose result nobody waits on; an exception escaping the task propagates
+		// out of the pop that runs it
+		template<std::invocable F>
+		void PushDetached(F&& function)
+		{
+			PushWrappedTask_(std::forward<F>(function));
+		}
+		// waits until there is a task to pop
 		void PopExecute();
+		// false if the queue was empty
+		bool TryPopExecute();
+		// false if no task was pushed before the timeout ran out
+		bool WaitPopExecute(std::chrono::steady_clock::duration timeout);
+		// takes up to max pending tasks out under a single lock and runs them in order; returns
+		// the number run. tasks pushed while the batch runs are left for the next call. if a
+		// task throws, the rest of the batch is put back at the front of the queue
+		size_t DrainExecute(size_t max = std::numeric_limits<size_t>::max());
 	private:
+		// types 
+		// growable FIFO ring; popping leaves an empty task in the slot, and the slots are kept
+		// when the ring empties, so a ring that has reached its working size stops allocating
+		class Ring
+		{
+		public:
+			bool IsEmpty() const;
+			size_t GetSize() const;
+			void Push(Task task);
+			Task Pop();
+			void Swap(Ring& other) noexcept;
+		private:
+			std::unique_ptr<Task[]> pSlots_;
+			size_t mask_ = 0;
+			size_t head_ = 0;
+			size_t size_ = 0;
+		};
 		// functions 
 		void PushWrappedTask_(Task task);
 		// data 
 		std::mutex mtx_;
-		std::deque<Task> tasks_;
+		std::condition_variable cv_;
+		size_t waiterCount_ = 0;
+		Ring tasks_;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace chil::ccr
+{
+	// move-only void() callable like std::move_only_function, except that callables of up to
+	// Capacity bytes are kept in the task's own storage; with the default capacity a task is
+	// one cache line and holds a lambda capturing a handful of pointers plus a std::promise.
+	// callables that are larger, over-aligned or that might throw when moved are put on the
+	// heap instead, so anything invocable can still be stored
+	template<size_t Capacity = 56>
+	class InlineTask
+	{
+	public:
+		InlineTask() = default;
+		template<typename F>
+			requires (!std::same_as<std::remove_cvref_t<F>, InlineTask> && std::invocable<std::decay_t<F>&>)
+		InlineTask(F&& function)
+		{
+			using D = std::decay_t<F>;
+			if constexpr (IsInline_<D>) {
+				::new (static_cast<void*>(storage_)) D(std::forward<F>(function));
+				pOps_ = &inlineOps_<D>;
+			}
+			else {
+				::new (static_cast<void*>(storage_)) D*(new D(std::forward<F>(function)));
+				pOps_ = &heapOps_<D>;
+			}
+		}
+		InlineTask(InlineTask&& other) noexcept
+		{
+			if (other.pOps_) {
+				other.pOps_->relocate(storage_, other.storage_);
+				pOps_ = std::exchange(other.pOps_, nullptr);
+			}
+		}
+		InlineTask& operator=(InlineTask&& other) noexcept
+		{
+			if (this != &other) {
+				Reset_();
+				if (other.pOps_) {
+					other.pOps_->relocate(storage_, other.storage_);
+					pOps_ = std::exchange(other.pOps_, nullptr);
+				}
+			}
+			return *this;
+		}
+		InlineTask(const InlineTask&) = delete;
+		InlineTask& operator=(const InlineTask&) = delete;
+		~InlineTask()
+		{
+			Reset_();
+		}
+		explicit operator bool() const
+		{
+			return pOps_ != nullptr;
+		}
+		void operator()()
+		{
+			pOps_->invoke(storage_);
+		}
+	private:
+		// types
+		struct Ops
+		{
+			void (*invoke)(void* p);
+			// move-constructs into dst and destroys what is left in src
+			void (*relocate)(void* dst, void* src) noexcept;
+			void (*destroy)(void* p) noexcept;
+		};
+		// functions
+		void Reset_() noexcept
+		{
+			if (pOps_) {
+				pOps_->destroy(storage_);
+				pOps_ = nullptr;
+			}
+		}
+		// constants
+		template<typename D>
+		static constexpr bool IsInline_ = sizeof(D) <= Capacity &&
+			alignof(D) <= alignof(std::max_align_t) &&
+			std::is_nothrow_move_constructible_v<D>;
+		template<typename D>
+		static constexpr Ops inlineOps_{
+			[](void* p) { (*std::launder(static_cast<D*>(p)))(); },
+			[](void* dst, void* src) noexcept {
+				auto pSrc = std::launder(static_cast<D*>(src));
+				::new (dst) D(std::move(*pSrc));
+				pSrc->~D();
+			},
+			[](void* p) noexcept { std::launder(static_cast<D*>(p))->~D(); },
+		};
+		template<typename D>
+		static constexpr Ops heapOps_{
+			[](void* p) { (**static_cast<D**>(p))(); },
+			[](void* dst, void* src) noexcept { ::new (dst) D*(*static_cast<D**>(src)); },
+			[](void* p) noexcept { delete *static_cast<D**>(p); },
+		};
+		// data
+		alignas(std::max_align_t) std::byte storage_[Capacity];
+		const Ops* pOps_ = nullptr;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace chil::ccr
+{
+	// process-wide free lists of fixed-size blocks, one pool per size and alignment. each
+	// thread keeps a small cache of blocks that it allocates from and frees to without any
+	// synchronization; a cache that runs dry takes a batch from the shared list, and one that
+	// grows past twice the batch size gives a batch back, so blocks freed on a consumer
+	// thread find their way back to the producer that allocates them
+	//
+	// blocks are only ever returned to the lists, never to the heap, so a pool holds on to
+	// its high-water mark of blocks for the life of the process
+	template<size_t Size, size_t Align>
+	class BlockPool
+	{
+	public:
+		static void* Allocate()
+		{
+			auto& cache = GetCache_();
+			if (!cache.pHead) {
+				cache.Refill();
+				if (!cache.pHead) {
+					return ::operator new(blockSize_, std::align_val_t{ blockAlign_ });
+				}
+			}
+			auto pNode = cache.pHead;
+			cache.pHead = pNode->pNext;
+			cache.count--;
+			return pNode;
+		}
+		static void Deallocate(void* p) noexcept
+		{
+			auto& cache = GetCache_();
+			cache.pHead = ::new (p) Node{ cache.pHead };
+			if (++cache.count > batchSize_ * 2) {
+				cache.Spill(batchSize_);
+			}
+		}
+	private:
+		// types
+		struct Node
+		{
+			Node* pNext;
+		};
+		struct Shared
+		{
+			std::mutex mtx;
+			Node* pHead = nullptr;
+		};
+		struct Cache
+		{
+			~Cache()
+			{
+				Spill(count);
+			}
+			void Refill()
+			{
+				auto& shared = GetShared_();
+				std::lock_guard lck{ shared.mtx };
+				for (; count < batchSize_ && shared.pHead; count++) {
+					auto pNode = shared.pHead;
+					shared.pHead = pNode->pNext;
+					pNode->pNext = pHead;
+					pHead = pNode;
+				}
+			}
+			void Spill(size_t n) noexcept
+			{
+				if (n == 0) {
+					return;
+				}
+				// unlink n nodes from the front of the cache and splice them onto the shared list
+				auto pFirst = pHead;
+				auto pLast = pHead;
+				for (size_t i = 1; i < n; i++) {
+					pLast = pLast->pNext;
+				}
+				pHead = pLast->pNext;
+				count -= n;
+				auto& shared = GetShared_();
+				std::lock_guard lck{ shared.mtx };
+				pLast->pNext = shared.pHead;
+				shared.pHead = pFirst;
+			}
+			Node* pHead = nullptr;
+			size_t count = 0;
+		};
+		// functions
+		static Shared& GetShared_()
+		{
+			// never destroyed, since thread caches spill into it at thread exit, which can
+			// come after static destruction has begun
+			static Shared* pShared = new Shared;
+			return *pShared;
+		}
+		static Cache& GetCache_()
+		{
+			thread_local Cache cache;
+			return cache;
+		}
+		// constants
+		static constexpr size_t blockSize_ = Size < sizeof(Node) ? sizeof(Node) : Size;
+		static constexpr size_t blockAlign_ = Align < alignof(Node) ? alignof(Node) : Align;
+		static constexpr size_t batchSize_ = 32;
+	};
+
+	// allocator for containers and std::promise that takes single objects from the BlockPool
+	// for their size; arrays go to the heap. T must be an object type (the value type a
+	// std::promise allocator is given does not matter, since it is rebound)
+	template<typename T>
+	class PoolAllocator
+	{
+	public:
+		using value_type = T;
+		PoolAllocator() = default;
+		template<typename U>
+		PoolAllocator(const PoolAllocator<U>&) noexcept {}
+		T* allocate(size_t n)
+		{
+			if (n == 1) {
+				return static_cast<T*>(BlockPool<sizeof(T), alignof(T)>::Allocate());
+			}
+			return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignof(T) }));
+		}
+		void deallocate(T* p, size_t n) noexcept
+		{
+			if (n == 1) {
+				BlockPool<sizeof(T), alignof(T)>::Deallocate(p);
+				return;
+			}
+			::operator delete(p, n * sizeof(T), std::align_val_t{ alignof(T) });
+		}
+		template<typename U>
+		bool operator==(const PoolAllocator<U>&) const noexcept
+		{
+			return true;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+namespace chil::ccr
+{
+	// shard picked by each thread on first use, handed out round robin
+	inline size_t GetThreadShard(size_t shardCount)
+	{
+		static std::atomic<size_t> nextShard = 0;
+		thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed);
+		return shard % shardCount;
+	}
+
+	// fixed set of counters striped over cache-line-aligned shards; a thread only adds into
+	// its own shard, so counting from many threads does not bounce one line between cores.
+	// reads sum over the shards and are a snapshot rather than a consistent cut (counts
+	// added while summing may or may not be included)
+	template<size_t N>
+	class ShardedCounters
+	{
+	public:
+		static constexpr size_t shardCount = 16;
+		void Add(size_t index, std::uint64_t amount = 1)
+		{
+			shards_[GetThreadShard(shardCount)].counts[index].fetch_add(amount, std::memory_order_relaxed);
+		}
+		std::uint64_t Get(size_t index) const
+		{
+			std::uint64_t total = 0;
+			for (auto& shard : shards_) {
+				total += shard.counts[index].load(std::memory_order_relaxed);
+			}
+			return total;
+		}
+		std::array<std::uint64_t, N> GetAll() const
+		{
+			std::array<std::uint64_t, N> totals{};
+			for (auto& shard : shards_) {
+				for (size_t i = 0; i < N; i++) {
+					totals[i] += shard.counts[i].load(std::memory_order_relaxed);
+				}
+			}
+			return totals;
+		}
+	private:
+		struct alignas(std::hardware_destructive_interference_size) Shard
+		{
+			std::array<std::atomic<std::uint64_t>, N> counts{};
+		};
+		std::array<Shard, shardCount> shards_{};
+	};
+
+	using ShardedCounter = ShardedCounters<1>;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <bit>
+#include <new>
+
+namespace chil::ccr
+{
+	// bounded single-producer/single-consumer ring; each side keeps a private copy of the
+	// other side's cursor and only reloads it when the ring looks full (or empty), so in the
+	// steady state the producer writes its slot and its own cursor and reads nothing the
+	// consumer is writing
+	template<typename T>
+	class SpscQueue
+	{
+	public:
+		// capacity is rounded up to the next power of two
+		SpscQueue(size_t capacity)
+			:
+			mask_{ std::bit_ceil(capacity < 2 ? size_t(2) : capacity) - 1 },
+			pSlots_{ std::make_unique<std::optional<T>[]>(mask_ + 1) }
+		{}
+		SpscQueue(const SpscQueue&) = delete;
+		SpscQueue& operator=(const SpscQueue&) = delete;
+		// producer only; returns false (leaving value untouched) if the queue is full
+		template<typename U>
+		bool TryPush(U&& value)
+		{
+			const size_t tail = tail_.load(std::memory_order_relaxed);
+			if (tail - cachedHead_ > mask_) {
+				cachedHead_ = head_.load(std::memory_order_acquire);
+				if (tail - cachedHead_ > mask_) {
+					return false;
+				}
+			}
+			pSlots_[tail & mask_].emplace(std::forward<U>(value));
+			tail_.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+		// consumer only; the oldest element, left in place until Pop, or nullptr if empty
+		T* Front()
+		{
+			const size_t head = head_.load(std::memory_order_relaxed);
+			if (head == cachedTail_) {
+				cachedTail_ = tail_.load(std::memory_order_acquire);
+				if (head == cachedTail_) {
+					return nullptr;
+				}
+			}
+			return &*pSlots_[head & mask_];
+		}
+		// consumer only; removes the element returned by Front
+		void Pop()
+		{
+			const size_t head = head_.load(std::memory_order_relaxed);
+			pSlots_[head & mask_].reset();
+			head_.store(head + 1, std::memory_order_release);
+		}
+		// consumer only; returns false (leaving out untouched) if the queue is empty
+		bool TryPop(T& out)
+		{
+			const auto pFront = Front();
+			if (!pFront) {
+				return false;
+			}
+			out = std::move(*pFront);
+			Pop();
+			return true;
+		}
+		// snapshot only
+		bool IsEmpty() const
+		{
+			return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+		}
+		size_t GetCapacity() const
+		{
+			return mask_ + 1;
+		}
+	private:
+		const size_t mask_;
+		std::unique_ptr<std::optional<T>[]> pSlots_;
+		// producer side: its cursor and its last view of the consumer's
+		alignas(std::hardware_destructive_interference_size) std::atomic<size_t> tail_ = 0;
+		size_t cachedHead_ = 0;
+		// consumer side
+		alignas(std::hardware_destructive_interference_size) std::atomic<size_t> head_ = 0;
+		size_t cachedTail_ = 0;
+	};
+}
\ No newline at end of file
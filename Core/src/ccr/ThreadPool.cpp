@@ -0,0 +1,163 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace chil::ccr
+{
+	namespace
+	{
+		// the pool and worker index of the calling thread, if it is a pool worker
+		struct WorkerIdentity
+		{
+			const void* pPool = nullptr;
+			size_t index = 0;
+		};
+		thread_local WorkerIdentity currentWorker;
+	}
+
+	ThreadPool::ThreadPool(size_t threadCount)
+	{
+		if (threadCount == 0) {
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+		}
+		// every deque exists before any worker starts looking at the others
+		for (size_t i = 0; i < threadCount; i++) {
+			workerPtrs_.push_back(std::make_unique<Worker>());
+		}
+		for (size_t i = 0; i < threadCount; i++) {
+			workerPtrs_[i]->thread = std::jthread{ &ThreadPool::WorkerKernel_, this, i };
+		}
+	}
+	ThreadPool::~ThreadPool()
+	{
+		stopping_.store(true, std::memory_order_seq_cst);
+		wakeEpoch_.fetch_add(1, std::memory_order_release);
+		wakeEpoch_.notify_all();
+		for (auto& pWorker : workerPtrs_) {
+			pWorker->thread.join();
+		}
+	}
+	size_t ThreadPool::GetThreadCount() const
+	{
+		return workerPtrs_.size();
+	}
+	void ThreadPool::Submit_(std::span<Task* const> tasks)
+	{
+		if (tasks.empty()) {
+			return;
+		}
+		if (currentWorker.pPool == this) {
+			auto& deque = workerPtrs_[currentWorker.index]->deque;
+			for (auto pTask : tasks) {
+				deque.Push(pTask);
+			}
+		}
+		else {
+			std::lock_guard lck{ injectionMtx_ };
+			injection_.insert(injection_.end(), tasks.begin(), tasks.end());
+			injectedCount_.fetch_add(tasks.size(), std::memory_order_release);
+		}
+		Wake_(tasks.size());
+	}
+	void ThreadPool::Wake_(size_t count)
+	{
+		// pairs with the sleeper registration in the kernel: either the worker's last look
+		// for work sees these tasks, or we see the worker as a sleeper and move the epoch
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleeperCount_.load(std::memory_order_relaxed) == 0) {
+			return;
+		}
+		wakeEpoch_.fetch_add(1, std::memory_order_release);
+		if (count == 1) {
+			wakeEpoch_.notify_one();
+		}
+		else {
+			wakeEpoch_.notify_all();
+		}
+	}
+	ThreadPool::Task* ThreadPool::FindTask_(size_t index)
+	{
+		if (auto pTask = workerPtrs_[index]->deque.Pop()) {
+			return *pTask;
+		}
+		if (auto pTask = TakeInjected_(index)) {
+			return pTask;
+		}
+		return Steal_(index);
+	}
+	ThreadPool::Task* ThreadPool::TakeInjected_(size_t index)
+	{
+		if (injectedCount_.load(std::memory_order_acquire) == 0) {
+			return nullptr;
+		}
+		size_t taken = 0;
+		Task* pFirst = nullptr;
+		{
+			std::lock_guard lck{ injectionMtx_ };
+			if (injection_.empty()) {
+				return nullptr;
+			}
+			pFirst = injection_.front();
+			injection_.pop_front();
+			// the rest of the batch goes where other idle workers can steal it
+			auto& deque = workerPtrs_[index]->deque;
+			for (; taken < injectionBatch_ && !injection_.empty(); taken++) {
+				deque.Push(injection_.front());
+				injection_.pop_front();
+			}
+			injectedCount_.fetch_sub(taken + 1, std::memory_order_relaxed);
+		}
+		if (taken) {
+			Wake_(taken);
+		}
+		return pFirst;
+	}
+	ThreadPool::Task* ThreadPool::Steal_(size_t index)
+	{
+		// victims are visited from a random starting point so that thieves spread out
+		thread_local std::uint32_t state = std::uint32_t(index) * 0x9E3779B9u + 1;
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		const auto count = workerPtrs_.size();
+		const auto start = size_t(state) % count;
+		for (size_t i = 0; i < count; i++) {
+			const auto victim = (start + i) % count;
+			if (victim == index) {
+				continue;
+			}
+			if (auto pTask = workerPtrs_[victim]->deque.Steal()) {
+				return *pTask;
+			}
+		}
+		return nullptr;
+	}
+	void ThreadPool::WorkerKernel_(size_t index) noexcept
+	{
+		currentWorker = { this, index };
+		const auto run = [](Task* pTask) {
+			std::unique_ptr<Task> pOwned{ pTask };
+			(*pOwned)();
+		};
+		while (true) {
+			if (const auto pTask = FindTask_(index)) {
+				run(pTask);
+				continue;
+			}
+			const auto epoch = wakeEpoch_.load(std::memory_order_acquire);
+			sleeperCount_.fetch_add(1, std::memory_order_seq_cst);
+			if (const auto pTask = FindTask_(index)) {
+				sleeperCount_.fetch_sub(1, std::memory_order_relaxed);
+				run(pTask);
+				continue;
+			}
+			// queued tasks are finished before stopping, so this is only checked once there
+			// is nothing left to find
+			if (stopping_.load(std::memory_order_seq_cst)) {
+				sleeperCount_.fetch_sub(1, std::memory_order_relaxed);
+				break;
+			}
+			wakeEpoch_.wait(epoch, std::memory_order_acquire);
+			sleeperCount_.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+#include "WorkStealingDeque.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace chil::ccr
+{
+	// fixed set of worker threads, each with a work-stealing deque of its own; a task pushed
+	// from a worker goes to the bottom of that worker's deque and is popped from there
+	// (newest first, while its data is still in cache), and a worker that runs dry steals
+	// from the top of the others' deques (oldest first, which tends to be the larger pieces
+	// of work). tasks pushed from other threads go through a shared injection queue, which
+	// idle workers take from in batches, so that outside producers do not contend with the
+	// workers for their deques
+	//
+	// idle workers park on an atomic wait and are woken only when there are parked workers
+	// to wake, so pushing to a busy pool takes no system call. on destruction the queued
+	// tasks are still run before the workers are joined
+	class ThreadPool
+	{
+		using Task = std::move_only_function<void()>;
+	public:
+		// threadCount of 0 means one worker per hardware thread
+		ThreadPool(size_t threadCount = 0);
+		~ThreadPool();
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		template<std::invocable F>
+		auto Push(F&& function)
+		{
+			using T = std::invoke_result_t<F>;
+			std::packaged_task<T()> pkg{ std::forward<F>(function) };
+			auto future = pkg.get_future();
+			Task* pTask = new Task{ [pkg = std::move(pkg)]() mutable { pkg(); } };
+			Submit_({ &pTask, 1 });
+			return future;
+		}
+		// for tasks whose result nobody waits on; an exception escaping the task ends the
+		// process, as one escaping a thread function would
+		template<std::invocable F>
+		void PushDetached(F&& function)
+		{
+			Task* pTask = new Task{ std::forward<F>(function) };
+			Submit_({ &pTask, 1 });
+		}
+		// pushes every function of the range at once, waking as many workers as there are
+		// tasks; the futures are in the order of the range
+		template<std::ranges::input_range R>
+			requires std::invocable<std::ranges::range_reference_t<R>>
+		auto PushBulk(R&& functions)
+		{
+			using T = std::invoke_result_t<std::ranges::range_reference_t<R>>;
+			std::vector<std::future<T>> futures;
+			std::vector<Task*> tasks;
+			for (auto&& function : functions) {
+				std::packaged_task<T()> pkg{ std::forward<decltype(function)>(function) };
+				futures.push_back(pkg.get_future());
+				tasks.push_back(new Task{ [pkg = std::move(pkg)]() mutable { pkg(); } });
+			}
+			Submit_(tasks);
+			return futures;
+		}
+		size_t GetThreadCount() const;
+	private:
+		// types
+		struct Worker
+		{
+			WorkStealingDeque<Task*> deque;
+			std::jthread thread;
+		};
+		// functions
+		void Submit_(std::span<Task* const> tasks);
+		void Wake_(size_t count);
+		Task* FindTask_(size_t index);
+		Task* TakeInjected_(size_t index);
+		Task* Steal_(size_t index);
+		void WorkerKernel_(size_t index) noexcept;
+		// data
+		// tasks moved from the injection queue to a worker's deque in one go
+		static constexpr size_t injectionBatch_ = 16;
+		std::vector<std::unique_ptr<Worker>> workerPtrs_;
+		std::mutex injectionMtx_;
+		std::deque<Task*> injection_;
+		std::atomic<size_t> injectedCount_ = 0;
+		// parking: a worker reads the epoch, announces itself as a sleeper, looks for work
+		// once more and then waits for the epoch to change
+		alignas(std::hardware_destructive_interference_size) std::atomic<std::uint32_t> wakeEpoch_ = 0;
+		std::atomic<size_t> sleeperCount_ = 0;
+		std::atomic<bool> stopping_ = false;
+	};
+}
\ No newline at end of file
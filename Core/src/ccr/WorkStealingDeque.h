@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace chil::ccr
+{
+	// Chase–Lev work-stealing deque (with the memory orderings of Lê et al., "Correct and
+	// Efficient Work-Stealing for Weak Memory Models"); the owning thread pushes and pops at
+	// the bottom without any read-modify-write except when taking the last element, and
+	// other threads steal from the top with a single CAS
+	//
+	// elements are held in atomics, so they must be trivially copyable (task pointers, say).
+	// the ring grows when full; a thief may still be reading the ring it was replaced with,
+	// so superseded rings are kept until the deque is destroyed
+	template<typename T>
+		requires std::is_trivially_copyable_v<T>
+	class WorkStealingDeque
+	{
+	public:
+		// capacity is rounded up to the next power of two
+		WorkStealingDeque(size_t capacity = 256)
+		{
+			ringPtrs_.push_back(std::make_unique<Ring>(std::bit_ceil(capacity < 2 ? size_t(2) : capacity)));
+			pRing_.store(ringPtrs_.back().get(), std::memory_order_relaxed);
+		}
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+		// owner only
+		void Push(T value)
+		{
+			const auto bottom = bottom_.load(std::memory_order_relaxed);
+			const auto top = top_.load(std::memory_order_acquire);
+			auto pRing = pRing_.load(std::memory_order_relaxed);
+			if (bottom - top > std::int64_t(pRing->mask)) {
+				pRing = Grow_(pRing, top, bottom);
+			}
+			pRing->Store(bottom, value);
+			std::atomic_thread_fence(std::memory_order_release);
+			bottom_.store(bottom + 1, std::memory_order_relaxed);
+		}
+		// owner only; the most recently pushed element
+		std::optional<T> Pop()
+		{
+			const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+			const auto pRing = pRing_.load(std::memory_order_relaxed);
+			bottom_.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto top = top_.load(std::memory_order_relaxed);
+			if (top > bottom) {
+				bottom_.store(bottom + 1, std::memory_order_relaxed);
+				return std::nullopt;
+			}
+			std::optional<T> value = pRing->Load(bottom);
+			if (top == bottom) {
+				// last element: race any thief for it
+				if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+					value.reset();
+				}
+				bottom_.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return value;
+		}
+		// any thread; the least recently pushed element, or nothing if the deque is empty or
+		// another thread took the element first
+		std::optional<T> Steal()
+		{
+			auto top = top_.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const auto bottom = bottom_.load(std::memory_order_acquire);
+			if (top >= bottom) {
+				return std::nullopt;
+			}
+			const auto value = pRing_.load(std::memory_order_acquire)->Load(top);
+			if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				return std::nullopt;
+			}
+			return value;
+		}
+		// snapshot only
+		bool IsEmpty() const
+		{
+			return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+		}
+	private:
+		// types
+		struct Ring
+		{
+			Ring(size_t capacity)
+				:
+				mask{ capacity - 1 },
+				pSlots{ std::make_unique<std::atomic<T>[]>(capacity) }
+			{}
+			T Load(std::int64_t i) const
+			{
+				return pSlots[size_t(i) & mask].load(std::memory_order_relaxed);
+			}
+			void Store(std::int64_t i, T value)
+			{
+				pSlots[size_t(i) & mask].store(value, std::memory_order_relaxed);
+			}
+			size_t mask;
+			std::unique_ptr<std::atomic<T>[]> pSlots;
+		};
+		// functions
+		Ring* Grow_(Ring* pRing, std::int64_t top, std::int64_t bottom)
+		{
+			auto pGrown = std::make_unique<Ring>((pRing->mask + 1) * 2);
+			for (auto i = top; i < bottom; i++) {
+				pGrown->Store(i, pRing->Load(i));
+			}
+			pRing = pGrown.get();
+			ringPtrs_.push_back(std::move(pGrown));
+			pRing_.store(pRing, std::memory_order_release);
+			return pRing;
+		}
+		// data
+		alignas(std::hardware_destructive_interference_size) std::atomic<std::int64_t> top_ = 0;
+		alignas(std::hardware_destructive_interference_size) std::atomic<std::int64_t> bottom_ = 0;
+		std::atomic<Ring*> pRing_;
+		// owner only
+		std::vector<std::unique_ptr<Ring>> ringPtrs_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "AsyncChannel.h"
+#include "Driver.h"
+#include "Policy.h"
+
+namespace chil::log
+{
+	AsyncChannel::AsyncChannel(std::vector<std::shared_ptr<IDriver>> driverPtrs, size_t capacity)
+		:
+		channel_{ std::move(driverPtrs) },
+		queue_{ capacity },
+		kernelThread_{ &AsyncChannel::MessageKernel_, this }
+	{}
+	AsyncChannel::~AsyncChannel()
+	{
+		stopping_.store(true);
+		wakeSignal_.fetch_add(1);
+		wakeSignal_.notify_one();
+		kernelThread_.join();
+	}
+	void AsyncChannel::Submit(Entry& e)
+	{
+		// entries raised while dispatching (from a driver, say) cannot wait on the ring
+		// that the dispatching thread itself is responsible for draining
+		if (std::this_thread::get_id() == kernelThread_.get_id()) {
+			channel_.Submit(e);
+			return;
+		}
+		Enqueue_(Message{ .entry = std::move(e) });
+	}
+	void AsyncChannel::Flush()
+	{
+		if (std::this_thread::get_id() == kernelThread_.get_id()) {
+			channel_.Flush();
+			return;
+		}
+		// the ring is FIFO, so once the kernel reaches this marker everything before it
+		// has been dispatched
+		std::binary_semaphore flushed{ 0 };
+		Enqueue_(Message{ .pFlushSignal = &flushed });
+		flushed.acquire();
+	}
+	void AsyncChannel::AttachDriver(std::shared_ptr<IDriver> pDriver)
+	{
+		channel_.AttachDriver(std::move(pDriver));
+	}
+	void AsyncChannel::AttachPolicy(std::shared_ptr<IPolicy> pPolicy)
+	{
+		channel_.AttachPolicy(std::move(pPolicy));
+	}
+	bool AsyncChannel::AcceptsLevel(Level level) const
+	{
+		return channel_.AcceptsLevel(level);
+	}
+	ChannelStats AsyncChannel::GetStats() const
+	{
+		return channel_.GetStats();
+	}
+	void AsyncChannel::Enqueue_(Message&& msg)
+	{
+		// when full, producers wait for the kernel rather than dropping entries: briefly by
+		// retrying, then parked until the kernel has drained another batch
+		for (int attempt = 0; !queue_.TryPush(std::move(msg)); attempt++) {
+			if (attempt < pushSpinCount_) {
+				std::this_thread::yield();
+				continue;
+			}
+			// registering before reading the round pairs with the kernel bumping the round
+			// before it checks for waiters: either it sees us and notifies, or we see the new
+			// round and do not block
+			fullWaiterCount_.fetch_add(1, std::memory_order_seq_cst);
+			const auto round = drainRound_.load(std::memory_order_seq_cst);
+			const bool pushed = queue_.TryPush(std::move(msg));
+			if (!pushed) {
+				drainRound_.wait(round, std::memory_order_seq_cst);
+			}
+			fullWaiterCount_.fetch_sub(1, std::memory_order_relaxed);
+			if (pushed) {
+				break;
+			}
+		}
+		// pairs with the fence in the kernel: either the kernel sees this push before it
+		// parks, or we see that it is parked and wake it
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleeping_.load(std::memory_order_relaxed)) {
+			wakeSignal_.fetch_add(1, std::memory_order_release);
+			wakeSignal_.notify_one();
+		}
+	}
+	size_t AsyncChannel::DrainBatch_()
+	{
+		size_t count = 0;
+		Message msg;
+		while (count < batchSize_ && queue_.TryPop(msg)) {
+			if (msg.pFlushSignal) {
+				channel_.Flush();
+				msg.pFlushSignal->release();
+			}
+			else {
+				channel_.Submit(msg.entry);
+			}
+			count++;
+		}
+		return count;
+	}
+	void AsyncChannel::MessageKernel_() noexcept
+	{
+		constexpr int spinLimit = 64;
+		int spins = 0;
+		while (true) {
+			if (DrainBatch_() > 0) {
+				spins = 0;
+				drainRound_.fetch_add(1, std::memory_order_seq_cst);
+				if (fullWaiterCount_.load(std::memory_order_seq_cst) > 0) {
+					drainRound_.notify_all();
+				}
+				continue;
+			}
+			// a push may have claimed a slot but not yet published it, keep polling
+			if (!queue_.IsEmpty() || ++spins < spinLimit) {
+				std::this_thread::yield();
+				continue;
+			}
+			if (stopping_.load()) {
+				break;
+			}
+			// park until a producer signals
+			const auto signal = wakeSignal_.load(std::memory_order_acquire);
+			sleeping_.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (queue_.IsEmpty() && !stopping_.load()) {
+				wakeSignal_.wait(signal, std::memory_order_acquire);
+			}
+			sleeping_.store(false, std::memory_order_relaxed);
+			spins = 0;
+		}
+		// pick up anything that raced in with shutdown
+		while (DrainBatch_() > 0) {}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include "Channel.h"
+#include "Entry.h"
+#include <Core/src/ccr/BoundedQueue.h>
+#include <atomic>
+#include <semaphore>
+#include <thread>
+
+namespace chil::log
+{
+	// channel that hands entries off to a background thread through a lock-free ring;
+	// policies and drivers run on that thread, so the submitting thread only pays for
+	// moving the entry into a slot
+	class AsyncChannel : public IChannel
+	{
+	public:
+		AsyncChannel(std::vector<std::shared_ptr<IDriver>> driverPtrs = {}, size_t capacity = 4096);
+		~AsyncChannel();
+		void Submit(Entry&) override;
+		// blocks until every entry submitted before the call has reached the drivers
+		void Flush() override;
+		void AttachDriver(std::shared_ptr<IDriver>) override;
+		void AttachPolicy(std::shared_ptr<IPolicy>) override;
+		// answered on the calling thread against the current policy snapshot
+		bool AcceptsLevel(Level) const override;
+		ChannelStats GetStats() const override;
+	private:
+		// types
+		struct Message
+		{
+			Entry entry;
+			std::binary_semaphore* pFlushSignal = nullptr;
+		};
+		// functions
+		void Enqueue_(Message&& msg);
+		size_t DrainBatch_();
+		void MessageKernel_() noexcept;
+		// data
+		static constexpr size_t batchSize_ = 256;
+		// failed pushes to a full ring before a producer parks
+		static constexpr int pushSpinCount_ = 16;
+		Channel channel_;
+		ccr::BoundedQueue<Message> queue_;
+		std::atomic<bool> sleeping_ = false;
+		std::atomic<bool> stopping_ = false;
+		std::atomic<unsigned int> wakeSignal_ = 0;
+		// bumped after each drained batch, for producers parked on a full ring
+		std::atomic<unsigned int> drainRound_ = 0;
+		std::atomic<unsigned int> fullWaiterCount_ = 0;
+		std::thread kernelThread_;
+	};
+}
\ No newline at end of file
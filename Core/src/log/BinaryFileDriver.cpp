@@ -0,0 +1,128 @@
+#include "BinaryFileDriver.h"
+#include "BinaryFormat.h"
+#include "Entry.h"
+#include <Core/src/utl/String.h>
+
+namespace chil::log
+{
+	BinaryFileDriver::BinaryFileDriver(std::filesystem::path path)
+	{
+		// create any directories in the path that don't yet exist
+		std::filesystem::create_directories(path.parent_path());
+		// open file, append if already exists
+		file_.open(path, file_.out | file_.app | file_.binary);
+		buffer_.reserve(bufferCapacity_);
+		// each session restarts site/format ids and the timestamp base
+		record_.push_back(char(bin::RecordType::Session));
+		record_.append(bin::magic, sizeof(bin::magic));
+		record_.push_back(char(bin::version));
+		CommitRecord_();
+	}
+	BinaryFileDriver::~BinaryFileDriver()
+	{
+		Flush();
+	}
+	void BinaryFileDriver::Submit(const Entry& e)
+	{
+		const auto siteId = InternSite_(e);
+		const auto formatId = e.deferredNote_ ? InternFormat_(e.deferredNote_->GetFormat()) : 0;
+
+		std::uint8_t flags = 0;
+		if (e.hResult_) {
+			flags |= bin::HasHResult;
+		}
+		if (e.deferredNote_) {
+			flags |= bin::HasDeferredNote;
+		}
+		if (e.showSourceLine_) {
+			flags |= *e.showSourceLine_ ? bin::ShowSourceLine : bin::HideSourceLine;
+		}
+		const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			Clock::ToSystem(e.timestamp_).time_since_epoch()).count();
+
+		record_.push_back(char(bin::RecordType::Entry));
+		record_.push_back(char(flags));
+		record_.push_back(char(e.level_));
+		bin::PutSigned(record_, timestamp - lastTimestamp_);
+		bin::PutVarint(record_, siteId);
+		if (e.hResult_) {
+			bin::PutU32(record_, *e.hResult_);
+		}
+		if (e.deferredNote_) {
+			bin::PutVarint(record_, formatId);
+			bin::PutArgs(record_, e.deferredNote_->GetArgs());
+		}
+		else if (!e.noteUtf8_.empty()) {
+			bin::PutBytes(record_, utl::AsChars(e.noteUtf8_));
+		}
+		else {
+			text_.clear();
+			utl::AppendUtf8(text_, e.note_);
+			bin::PutBytes(record_, text_);
+		}
+		lastTimestamp_ = timestamp;
+		CommitRecord_();
+	}
+	void BinaryFileDriver::Flush()
+	{
+		WriteBuffer_();
+		file_.flush();
+	}
+	std::uint64_t BinaryFileDriver::GetBytesWritten() const
+	{
+		return bytesWritten_.load(std::memory_order_relaxed);
+	}
+	std::uint64_t BinaryFileDriver::InternSite_(const Entry& e)
+	{
+		// sites are static descriptors, so their address identifies them
+		static const Site unknownSite{ L"", L"", -1 };
+		const auto& site = e.pSite_ ? *e.pSite_ : unknownSite;
+		if (auto i = siteIds_.find(&site); i != siteIds_.end()) {
+			return i->second;
+		}
+		const auto id = std::uint64_t(siteIds_.size());
+		siteIds_.emplace(&site, id);
+		record_.push_back(char(bin::RecordType::Site));
+		bin::PutVarint(record_, id);
+		bin::PutSigned(record_, site.GetLine());
+		text_.clear();
+		utl::AppendUtf8(text_, site.GetFile() ? site.GetFile() : L"");
+		bin::PutBytes(record_, text_);
+		text_.clear();
+		utl::AppendUtf8(text_, site.GetFunction() ? site.GetFunction() : L"");
+		bin::PutBytes(record_, text_);
+		CommitRecord_();
+		return id;
+	}
+	std::uint64_t BinaryFileDriver::InternFormat_(std::wstring_view format)
+	{
+		// deferred formats are literals, so their address identifies them
+		if (auto i = formatIds_.find(format.data()); i != formatIds_.end()) {
+			return i->second;
+		}
+		const auto id = std::uint64_t(formatIds_.size());
+		formatIds_.emplace(format.data(), id);
+		record_.push_back(char(bin::RecordType::Format));
+		bin::PutVarint(record_, id);
+		text_.clear();
+		utl::AppendUtf8(text_, format);
+		bin::PutBytes(record_, text_);
+		CommitRecord_();
+		return id;
+	}
+	void BinaryFileDriver::CommitRecord_()
+	{
+		bin::PutVarint(buffer_, record_.size());
+		buffer_ += record_;
+		record_.clear();
+		if (buffer_.size() >= bufferCapacity_) {
+			WriteBuffer_();
+		}
+	}
+	void BinaryFileDriver::WriteBuffer_()
+	{
+		file_.write(buffer_.data(), buffer_.size());
+		bytesWritten_.fetch_add(buffer_.size(), std::memory_order_relaxed);
+		buffer_.clear();
+	}
+}
\ No newline at end of file
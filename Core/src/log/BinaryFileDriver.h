@@ -0,0 +1,42 @@
+#pragma once
+#include "Driver.h"
+#include "Site.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace chil::log
+{
+	class IBinaryFileDriver : public IDriver {};
+
+	// writes entries as compact length-prefixed records (see BinaryFormat.h); source sites
+	// and deferred note formats are interned so each is written once per session, and
+	// deferred notes are stored unexpanded
+	class BinaryFileDriver : public IBinaryFileDriver
+	{
+	public:
+		BinaryFileDriver(std::filesystem::path path);
+		~BinaryFileDriver();
+		void Submit(const Entry&) override;
+		void Flush() override;
+		std::uint64_t GetBytesWritten() const override;
+	private:
+		// functions
+		std::uint64_t InternSite_(const Entry&);
+		std::uint64_t InternFormat_(std::wstring_view format);
+		void CommitRecord_();
+		void WriteBuffer_();
+		// data
+		static constexpr size_t bufferCapacity_ = 1 << 16;
+		std::ofstream file_;
+		std::string buffer_;
+		std::string record_;
+		std::string text_;
+		std::unordered_map<const Site*, std::uint64_t> siteIds_;
+		std::unordered_map<const wchar_t*, std::uint64_t> formatIds_;
+		long long lastTimestamp_ = 0;
+		std::atomic<std::uint64_t> bytesWritten_ = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "BinaryFileReader.h"
+#include "BinaryFormat.h"
+#include <Core/src/utl/String.h>
+#include <algorithm>
+#include <array>
+
+namespace chil::log
+{
+	BinaryFileReader::SiteRecord::SiteRecord(std::wstring fileName, std::wstring functionName, int line)
+		:
+		file{ std::move(fileName) },
+		function{ std::move(functionName) },
+		site{ file.c_str(), function.c_str(), line }
+	{}
+
+	BinaryFileReader::BinaryFileReader(std::filesystem::path path)
+		:
+		file_{ path, std::ios::in | std::ios::binary }
+	{}
+	bool BinaryFileReader::Next(Entry& e)
+	{
+		while (ReadRecord_()) {
+			bin::Cursor cursor{ record_ };
+			std::uint8_t type;
+			if (!cursor.GetU8(type)) {
+				continue;
+			}
+			switch (bin::RecordType(type)) {
+			case bin::RecordType::Session:
+				sites_.clear();
+				formats_.clear();
+				timestamp_ = 0;
+				break;
+			case bin::RecordType::Site:
+			{
+				std::uint64_t id;
+				std::int64_t line;
+				std::string_view file, function;
+				if (!cursor.GetVarint(id) || !cursor.GetSigned(line) ||
+					!cursor.GetBytes(file) || !cursor.GetBytes(function)) {
+					return false;
+				}
+				sites_[id] = std::make_unique<SiteRecord>(utl::FromUtf8(file), utl::FromUtf8(function), int(line));
+				break;
+			}
+			case bin::RecordType::Format:
+			{
+				std::uint64_t id;
+				std::string_view format;
+				if (!cursor.GetVarint(id) || !cursor.GetBytes(format)) {
+					return false;
+				}
+				formats_[id] = utl::FromUtf8(format);
+				break;
+			}
+			case bin::RecordType::Entry:
+				return DecodeEntry_(std::string_view{ record_ }.substr(1), e);
+			default:
+				// unknown record types are skipped so that older readers tolerate newer files
+				break;
+			}
+		}
+		return false;
+	}
+	bool BinaryFileReader::ReadRecord_()
+	{
+		std::uint64_t size = 0;
+		for (int shift = 0; ; shift += 7) {
+			const auto c = file_.get();
+			if (c == std::char_traits<char>::eof() || shift >= 64) {
+				return false;
+			}
+			size |= std::uint64_t(c & 0x7F) << shift;
+			if (!(c & 0x80)) {
+				break;
+			}
+		}
+		// guard against reading a corrupt length as a huge allocation
+		if (size > maxRecordSize_) {
+			return false;
+		}
+		record_.resize(size);
+		file_.read(record_.data(), std::streamsize(size));
+		return file_.gcount() == std::streamsize(size);
+	}
+	bool BinaryFileReader::DecodeEntry_(std::string_view body, Entry& e)
+	{
+		static const Site unknownSite{ L"?", L"?", -1 };
+		bin::Cursor cursor{ body };
+		std::uint8_t flags, level;
+		std::int64_t delta;
+		std::uint64_t siteId;
+		if (!cursor.GetU8(flags) || !cursor.GetU8(level) ||
+			!cursor.GetSigned(delta) || !cursor.GetVarint(siteId)) {
+			return false;
+		}
+		e = Entry{};
+		e.level_ = Level(level);
+		timestamp_ += delta;
+		e.timestamp_ = Clock::FromSystem(std::chrono::system_clock::time_point{
+			std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{ timestamp_ })
+		});
+		const auto i = sites_.find(siteId);
+		e.pSite_ = i != sites_.end() ? &i->second->site : &unknownSite;
+		if (flags & bin::ShowSourceLine) {
+			e.showSourceLine_ = true;
+		}
+		else if (flags & bin::HideSourceLine) {
+			e.showSourceLine_ = false;
+		}
+		if (flags & bin::HasHResult) {
+			std::uint32_t hr;
+			if (!cursor.GetU32(hr)) {
+				return false;
+			}
+			e.hResult_ = hr;
+		}
+		if (flags & bin::HasDeferredNote) {
+			std::uint64_t formatId;
+			std::array<DeferredNote::Arg, 8> args{};
+			size_t count = 0;
+			if (!cursor.GetVarint(formatId) || !bin::GetArgs(cursor, args, count)) {
+				return false;
+			}
+			if (const auto f = formats_.find(formatId); f != formats_.end()) {
+				e.deferredNote_.emplace(std::wstring_view{ f->second }, std::span<const DeferredNote::Arg>{ args.data(), count });
+			}
+			else {
+				e.note_ = L"[unknown format]";
+			}
+		}
+		else {
+			std::string_view note;
+			if (!cursor.GetBytes(note)) {
+				return false;
+			}
+			e.note_ = utl::FromUtf8(note);
+		}
+		return true;
+	}
+}
\ No newline at end of file
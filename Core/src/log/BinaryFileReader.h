@@ -0,0 +1,40 @@
+#pragma once
+#include "Entry.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace chil::log
+{
+	// decodes files written by BinaryFileDriver back into entries
+	class BinaryFileReader
+	{
+	public:
+		BinaryFileReader(std::filesystem::path path);
+		// decodes the next entry into e; false at end of file or at a truncated/corrupt tail
+		// the entry refers to strings owned by the reader and is valid until the next call
+		bool Next(Entry& e);
+	private:
+		// types
+		struct SiteRecord
+		{
+			SiteRecord(std::wstring fileName, std::wstring functionName, int line);
+			std::wstring file;
+			std::wstring function;
+			Site site;
+		};
+		// functions
+		bool ReadRecord_();
+		bool DecodeEntry_(std::string_view body, Entry& e);
+		// data
+		static constexpr std::uint64_t maxRecordSize_ = 1 << 24;
+		std::ifstream file_;
+		std::string record_;
+		std::unordered_map<std::uint64_t, std::unique_ptr<SiteRecord>> sites_;
+		std::unordered_map<std::uint64_t, std::wstring> formats_;
+		long long timestamp_ = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#pragma once
+#include "DeferredNote.h"
+#include <array>
+#include <bit>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+// record layout shared by BinaryFileDriver and BinaryFileReader
+//
+// a file is a sequence of records, each a varint body length followed by the body; the
+// first byte of the body is the record type:
+//   Session: magic[4] version          (resets ids and the timestamp base)
+//   Site:    id line file function     (strings are varint length + UTF-8)
+//   Format:  id format
+//   Entry:   flags level dt site [hr:u32] (format argc {kind value}... | note)
+// integers are LEB128 varints (zigzag for signed), dt is the nanosecond delta from the
+// previous entry of the session
+namespace chil::log::bin
+{
+	inline constexpr char magic[4] = { 'C', 'H', 'L', 'B' };
+	inline constexpr std::uint8_t version = 1;
+
+	enum class RecordType : std::uint8_t
+	{
+		Session = 1,
+		Site = 2,
+		Format = 3,
+		Entry = 4,
+	};
+
+	enum EntryFlags : std::uint8_t
+	{
+		HasHResult = 0x01,
+		HasDeferredNote = 0x02,
+		ShowSourceLine = 0x04,
+		HideSourceLine = 0x08,
+	};
+
+	inline void PutVarint(std::string& out, std::uint64_t v)
+	{
+		while (v >= 0x80) {
+			out.push_back(char(v | 0x80));
+			v >>= 7;
+		}
+		out.push_back(char(v));
+	}
+	inline void PutSigned(std::string& out, std::int64_t v)
+	{
+		PutVarint(out, (std::uint64_t(v) << 1) ^ std::uint64_t(v >> 63));
+	}
+	inline void PutU32(std::string& out, std::uint32_t v)
+	{
+		for (int i = 0; i < 4; i++) {
+			out.push_back(char(v >> (i * 8)));
+		}
+	}
+	inline void PutF64(std::string& out, double v)
+	{
+		const auto bits = std::bit_cast<std::uint64_t>(v);
+		PutU32(out, std::uint32_t(bits));
+		PutU32(out, std::uint32_t(bits >> 32));
+	}
+	inline void PutBytes(std::string& out, std::string_view bytes)
+	{
+		PutVarint(out, bytes.size());
+		out += bytes;
+	}
+
+	// FNV-1a, for detecting torn or corrupt records
+	inline std::uint32_t Checksum(std::string_view data)
+	{
+		std::uint32_t hash = 2166136261u;
+		for (const char c : data) {
+			hash = (hash ^ std::uint8_t(c)) * 16777619u;
+		}
+		return hash;
+	}
+
+	// bounds-checked reader over a record body; every getter returns false on underrun
+	class Cursor
+	{
+	public:
+		Cursor(std::string_view data) : data_{ data } {}
+		bool GetVarint(std::uint64_t& v)
+		{
+			v = 0;
+			for (int shift = 0; shift < 64; shift += 7) {
+				if (pos_ >= data_.size()) {
+					return false;
+				}
+				const auto b = (std::uint8_t)data_[pos_++];
+				v |= std::uint64_t(b & 0x7F) << shift;
+				if (!(b & 0x80)) {
+					return true;
+				}
+			}
+			return false;
+		}
+		bool GetSigned(std::int64_t& v)
+		{
+			std::uint64_t u;
+			if (!GetVarint(u)) {
+				return false;
+			}
+			v = std::int64_t(u >> 1) ^ -std::int64_t(u & 1);
+			return true;
+		}
+		bool GetU8(std::uint8_t& v)
+		{
+			if (pos_ >= data_.size()) {
+				return false;
+			}
+			v = (std::uint8_t)data_[pos_++];
+			return true;
+		}
+		bool GetU32(std::uint32_t& v)
+		{
+			if (data_.size() - pos_ < 4) {
+				return false;
+			}
+			v = 0;
+			for (int i = 0; i < 4; i++) {
+				v |= std::uint32_t((std::uint8_t)data_[pos_++]) << (i * 8);
+			}
+			return true;
+		}
+		bool GetF64(double& v)
+		{
+			std::uint32_t lo, hi;
+			if (!GetU32(lo) || !GetU32(hi)) {
+				return false;
+			}
+			v = std::bit_cast<double>(std::uint64_t(lo) | (std::uint64_t(hi) << 32));
+			return true;
+		}
+		bool GetBytes(std::string_view& bytes)
+		{
+			std::uint64_t size;
+			if (!GetVarint(size) || data_.size() - pos_ < size) {
+				return false;
+			}
+			bytes = data_.substr(pos_, size);
+			pos_ += size;
+			return true;
+		}
+	private:
+		std::string_view data_;
+		size_t pos_ = 0;
+	};
+
+	// deferred note arguments: count, then {kind value} each
+	inline void PutArgs(std::string& out, std::span<const DeferredNote::Arg> args)
+	{
+		out.push_back(char(args.size()));
+		for (const auto& a : args) {
+			out.push_back(char(a.kind));
+			switch (a.kind) {
+			case DeferredNote::Kind::Signed: PutSigned(out, a.value.i); break;
+			case DeferredNote::Kind::Unsigned: PutVarint(out, a.value.u); break;
+			case DeferredNote::Kind::Float: PutF64(out, a.value.f); break;
+			case DeferredNote::Kind::Bool: out.push_back(char(a.value.b)); break;
+			case DeferredNote::Kind::Char: PutVarint(out, std::uint64_t(a.value.c)); break;
+			}
+		}
+	}
+	inline bool GetArgs(Cursor& cursor, std::array<DeferredNote::Arg, 8>& args, size_t& count)
+	{
+		std::uint8_t n;
+		if (!cursor.GetU8(n)) {
+			return false;
+		}
+		count = std::min<size_t>(n, args.size());
+		for (size_t i = 0; i < count; i++) {
+			auto& a = args[i];
+			std::uint8_t kind;
+			if (!cursor.GetU8(kind)) {
+				return false;
+			}
+			a.kind = DeferredNote::Kind(kind);
+			bool ok = false;
+			switch (a.kind) {
+			case DeferredNote::Kind::Signed:
+			{
+				std::int64_t v;
+				ok = cursor.GetSigned(v);
+				a.value.i = v;
+				break;
+			}
+			case DeferredNote::Kind::Unsigned:
+			{
+				std::uint64_t v;
+				ok = cursor.GetVarint(v);
+				a.value.u = v;
+				break;
+			}
+			case DeferredNote::Kind::Float:
+				ok = cursor.GetF64(a.value.f);
+				break;
+			case DeferredNote::Kind::Bool:
+			{
+				std::uint8_t v;
+				ok = cursor.GetU8(v);
+				a.value.b = v != 0;
+				break;
+			}
+			case DeferredNote::Kind::Char:
+			{
+				std::uint64_t v;
+				ok = cursor.GetVarint(v);
+				a.value.c = wchar_t(v);
+				break;
+			}
+			}
+			if (!ok) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
\ No newline at end of file
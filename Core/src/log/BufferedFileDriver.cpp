@@ -0,0 +1,144 @@
+#include "BufferedFileDriver.h"
+#include "Entry.h"
+#include "Exception.h"
+#include "TextFormatter.h"
+#include <Core/src/win/ChilWin.h>
+#include <algorithm>
+
+namespace chil::log
+{
+	BufferedFileDriver::BufferedFileDriver(std::filesystem::path path, std::shared_ptr<ITextFormatter> pFormatter, Durability durability)
+		:
+		durability_{ durability },
+		pFormatter_{ std::move(pFormatter) }
+	{
+		// create any directories in the path that don't yet exist
+		std::filesystem::create_directories(path.parent_path());
+		// open file for appending, readers may look at it while we write
+		const auto hFile = CreateFileW(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr,
+			OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (hFile == INVALID_HANDLE_VALUE) {
+			throw DriverException{ L"Failed to open log file " + path.wstring() };
+		}
+		hFile_ = hFile;
+		buffer_.reserve(durability_.commitBytes * 2);
+		committing_.reserve(durability_.commitBytes * 2);
+		commitThread_ = std::thread{ &BufferedFileDriver::CommitKernel_, this };
+	}
+	BufferedFileDriver::~BufferedFileDriver()
+	{
+		{
+			std::lock_guard lck{ mtx_ };
+			stopping_ = true;
+		}
+		cv_.notify_one();
+		commitThread_.join();
+		Commit_(true);
+		CloseHandle(hFile_);
+	}
+	void BufferedFileDriver::Submit(const Entry& e)
+	{
+		if (!pFormatter_) {
+			return;
+		}
+		thread_local std::string text;
+		text.clear();
+		pFormatter_->FormatUtf8To(text, e);
+
+		const bool syncNow = e.level_ <= durability_.syncLevel;
+		bool wake = false;
+		bool backlogged = false;
+		{
+			std::lock_guard lck{ mtx_ };
+			if (buffer_.empty()) {
+				oldestPending_ = std::chrono::steady_clock::now();
+			}
+			buffer_ += text;
+			stats_.entries++;
+			wake = buffer_.size() >= durability_.commitBytes;
+			backlogged = buffer_.size() >= durability_.commitBytes * backlogFactor_;
+		}
+		if (syncNow || backlogged) {
+			Commit_(syncNow || durability_.syncData);
+		}
+		else if (wake) {
+			cv_.notify_one();
+		}
+	}
+	void BufferedFileDriver::SetFormatter(std::shared_ptr<ITextFormatter> pFormatter)
+	{
+		pFormatter_ = std::move(pFormatter);
+	}
+	void BufferedFileDriver::Flush()
+	{
+		Commit_(true);
+	}
+	BufferedFileDriver::Stats BufferedFileDriver::GetStats() const
+	{
+		std::lock_guard lck{ mtx_ };
+		return stats_;
+	}
+	std::uint64_t BufferedFileDriver::GetBytesWritten() const
+	{
+		return GetStats().bytes;
+	}
+	void BufferedFileDriver::Commit_(bool sync)
+	{
+		std::lock_guard commitLck{ commitMtx_ };
+		{
+			std::lock_guard lck{ mtx_ };
+			std::swap(buffer_, committing_);
+		}
+		// WriteFile takes a 32-bit length
+		constexpr size_t maxChunk = 1 << 30;
+		bool failed = false;
+		for (size_t offset = 0; offset < committing_.size(); ) {
+			const auto chunk = (DWORD)std::min(committing_.size() - offset, maxChunk);
+			DWORD written = 0;
+			if (!WriteFile(hFile_, committing_.data() + offset, chunk, &written, nullptr) || written == 0) {
+				// nowhere to report this from inside the log system; the data is dropped
+				// rather than retried so that a broken disk cannot grow the buffer forever
+				failed = true;
+				break;
+			}
+			offset += written;
+			unsynced_ = true;
+		}
+		bool synced = false;
+		if (sync && unsynced_) {
+			synced = FlushFileBuffers(hFile_) != FALSE;
+			unsynced_ = false;
+		}
+		std::lock_guard lck{ mtx_ };
+		if (!committing_.empty() && !failed) {
+			stats_.commits++;
+			stats_.bytes += committing_.size();
+		}
+		stats_.syncs += synced ? 1 : 0;
+		stats_.failedWrites += failed ? 1 : 0;
+		committing_.clear();
+	}
+	void BufferedFileDriver::CommitKernel_()
+	{
+		std::unique_lock lck{ mtx_ };
+		while (true) {
+			cv_.wait(lck, [this] { return stopping_ || !buffer_.empty(); });
+			if (stopping_) {
+				return;
+			}
+			// let the oldest entry wait out the interval unless the size rule fires first;
+			// the buffer may also be emptied meanwhile by a Flush or a synced entry
+			cv_.wait_until(lck, oldestPending_ + durability_.commitInterval, [this] {
+				return stopping_ || buffer_.empty() || buffer_.size() >= durability_.commitBytes;
+			});
+			if (stopping_) {
+				return;
+			}
+			if (!buffer_.empty()) {
+				lck.unlock();
+				Commit_(durability_.syncData);
+				lck.lock();
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include "Driver.h"
+#include "Level.h"
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace chil::log
+{
+	class IBufferedFileDriver : public ITextDriver {};
+
+	// text file driver that accumulates UTF-8 output in its own buffer and commits it as a
+	// single write followed by a sync of the file data (group commit); producers keep
+	// filling the buffer while a commit is in flight
+	class BufferedFileDriver : public IBufferedFileDriver
+	{
+	public:
+		// types
+		// a commit happens when any rule fires, and on Flush
+		struct Durability
+		{
+			// buffered bytes that wake the commit thread
+			size_t commitBytes = 1 << 16;
+			// longest time an entry may wait in the buffer
+			std::chrono::milliseconds commitInterval{ 200 };
+			// entries at this severity or worse are committed and synced before Submit returns
+			Level syncLevel = Level::Error;
+			// when false, size/time commits only hand data to the OS without syncing it
+			bool syncData = true;
+		};
+		struct Stats
+		{
+			size_t entries = 0;
+			size_t bytes = 0;
+			size_t commits = 0;
+			size_t syncs = 0;
+			size_t failedWrites = 0;
+		};
+		// functions
+		BufferedFileDriver(std::filesystem::path path, std::shared_ptr<ITextFormatter> pFormatter = {}, Durability durability = {});
+		~BufferedFileDriver();
+		void Submit(const Entry&) override;
+		void SetFormatter(std::shared_ptr<ITextFormatter> pFormatter) override;
+		// commits and syncs everything submitted so far
+		void Flush() override;
+		Stats GetStats() const;
+		std::uint64_t GetBytesWritten() const override;
+	private:
+		// functions
+		void Commit_(bool sync);
+		void CommitKernel_();
+		// data
+		// producers that get this far ahead of the commit thread write the buffer themselves
+		static constexpr size_t backlogFactor_ = 4;
+		Durability durability_;
+		std::shared_ptr<ITextFormatter> pFormatter_;
+		// HANDLE, kept opaque so that the header does not pull in Windows.h
+		void* hFile_ = nullptr;
+		mutable std::mutex mtx_;
+		std::condition_variable cv_;
+		std::string buffer_;
+		std::chrono::steady_clock::time_point oldestPending_;
+		Stats stats_;
+		bool stopping_ = false;
+		// serializes commits; owns the buffer being written and the unsynced state
+		std::mutex commitMtx_;
+		std::string committing_;
+		bool unsynced_ = false;
+		std::thread commitThread_;
+	};
+}
\ No newline at end of file
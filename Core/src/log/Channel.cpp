@@ -1,40 +1,128 @@
 #pragma once
 #include "Channel.h"
+#include "Clock.h"
 #include "Driver.h"
 #include "Policy.h"
+#include "Entry.h"
+#include <algorithm>
+#include <typeinfo>
 
 namespace chil::log
 {
 	Channel::Channel(std::vector<std::shared_ptr<IDriver>> driverPtrs)
-		:
-		driverPtrs_{ std::move(driverPtrs) }
-	{}
+	{
+		// timestamps are converted to wall-clock time against a pairing taken once; taking
+		// it here keeps it off the path of the first entry
+		Clock::Calibrate();
+		auto pSnapshot = std::make_unique<Snapshot>(Snapshot{ .driverPtrs = std::move(driverPtrs) });
+		for (size_t i = 0; i < pSnapshot->driverPtrs.size(); i++) {
+			pSnapshot->driverMetricsPtrs.push_back(std::make_shared<DriverMetrics>());
+		}
+		snapshotPtrs_.push_back(std::move(pSnapshot));
+		pSnapshot_.store(snapshotPtrs_.back().get(), std::memory_order_release);
+	}
 	Channel::~Channel()
-	{}
+	{
+		// a last flush hands over whatever the policies are still holding back (drop counts
+		// of a flood that was followed by silence, say)
+		try {
+			Flush();
+		}
+		catch (...) {}
+	}
 	void Channel::Submit(Entry& e)
 	{
-		for (auto& pPolicy : policyPtrs_) {
-			if (!pPolicy->TransformFilter(e)) {
+		const auto& snapshot = *pSnapshot_.load(std::memory_order_acquire);
+		submitted_.Add(std::min(size_t(e.level_), levelCount - 1));
+		Dispatch_(snapshot, e, 0);
+	}
+	void Channel::Flush()
+	{
+		const auto& snapshot = *pSnapshot_.load(std::memory_order_acquire);
+		// entries held back by a policy continue from the policy after it
+		std::vector<Entry> pending;
+		for (size_t i = 0; i < snapshot.policyPtrs.size(); i++) {
+			pending.clear();
+			snapshot.policyPtrs[i]->TakePending(pending);
+			for (auto& e : pending) {
+				Dispatch_(snapshot, e, i + 1);
+			}
+		}
+		for (size_t i = 0; i < snapshot.driverPtrs.size(); i++) {
+			const auto start = Clock::now();
+			snapshot.driverPtrs[i]->Flush();
+			snapshot.driverMetricsPtrs[i]->flush.Record(Clock::now() - start);
+		}
+	}
+	void Channel::Dispatch_(const Snapshot& snapshot, Entry& e, size_t firstPolicy)
+	{
+		for (size_t i = firstPolicy; i < snapshot.policyPtrs.size(); i++) {
+			if (!snapshot.policyPtrs[i]->TransformFilter(e)) {
+				snapshot.filteredPtrs[i]->Add(0);
 				return;
 			}
 		}
-		for (auto& pDriver : driverPtrs_) {
-			pDriver->Submit(e);
+		for (size_t i = 0; i < snapshot.driverPtrs.size(); i++) {
+			const auto start = Clock::now();
+			snapshot.driverPtrs[i]->Submit(e);
+			snapshot.driverMetricsPtrs[i]->submit.Record(Clock::now() - start);
 		}
 		// TODO: log case when there are no drivers?
 	}
-	void Channel::Flush()
+	template<typename F>
+	void Channel::Update_(F&& modify)
 	{
-		for (auto& pDriver : driverPtrs_) {
-			pDriver->Flush();
-		}
+		std::lock_guard lck{ updateMtx_ };
+		auto pNext = std::make_unique<Snapshot>(*pSnapshot_.load(std::memory_order_relaxed));
+		modify(*pNext);
+		pSnapshot_.store(pNext.get(), std::memory_order_release);
+		snapshotPtrs_.push_back(std::move(pNext));
 	}
 	void Channel::AttachDriver(std::shared_ptr<IDriver> pDriver)
 	{
-		driverPtrs_.push_back(std::move(pDriver));
+		Update_([&](Snapshot& s) {
+			s.driverPtrs.push_back(std::move(pDriver));
+			s.driverMetricsPtrs.push_back(std::make_shared<DriverMetrics>());
+		});
 	}
 	void Channel::AttachPolicy(std::shared_ptr<IPolicy> pPolicy)
 	{
-		policyPtrs_.push_back(std::move(pPolicy));
+		Update_([&](Snapshot& s) {
+			s.policyPtrs.push_back(std::move(pPolicy));
+			s.filteredPtrs.push_back(std::make_shared<ccr::ShardedCounter>());
+		});
+	}
+	bool Channel::AcceptsLevel(Level level) const
+	{
+		const auto& snapshot = *pSnapshot_.load(std::memory_order_acquire);
+		for (auto& pPolicy : snapshot.policyPtrs) {
+			if (level > pPolicy->GetMaxLevel()) {
+				return false;
+			}
+		}
+		return true;
+	}
+	ChannelStats Channel::GetStats() const
+	{
+		const auto& snapshot = *pSnapshot_.load(std::memory_order_acquire);
+		ChannelStats stats{ .submitted = submitted_.GetAll() };
+		for (auto& pFiltered : snapshot.filteredPtrs) {
+			stats.filtered.push_back(pFiltered->Get(0));
+		}
+		for (size_t i = 0; i < snapshot.driverPtrs.size(); i++) {
+			// MSVC type names read "class chil::log::SimpleFileDriver"; the unqualified name
+			// is enough to tell drivers apart
+			std::string_view name = typeid(*snapshot.driverPtrs[i]).name();
+			if (const auto end = name.find_last_of(" :"); end != std::string_view::npos) {
+				name.remove_prefix(end + 1);
+			}
+			stats.drivers.push_back({
+				.name = std::string{ name },
+				.bytesWritten = snapshot.driverPtrs[i]->GetBytesWritten(),
+				.submit = snapshot.driverMetricsPtrs[i]->submit.GetSnapshot(),
+				.flush = snapshot.driverMetricsPtrs[i]->flush.GetSnapshot(),
+			});
+		}
+		return stats;
 	}
 }
\ No newline at end of file
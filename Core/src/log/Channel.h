@@ -1,6 +1,10 @@
 #pragma once
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
+#include "Level.h"
+#include "Metrics.h"
 
 namespace chil::log
 {
@@ -16,8 +20,17 @@ namespace chil::log
 		virtual void Flush() = 0;
 		virtual void AttachDriver(std::shared_ptr<IDriver>) = 0;
 		virtual void AttachPolicy(std::shared_ptr<IPolicy>) = 0;
+		// cheap pre-check so that callers can skip building entries that would be filtered
+		virtual bool AcceptsLevel(Level) const { return true; }
+		virtual ChannelStats GetStats() const { return {}; }
 	};
 
+	// drivers and policies are published as immutable snapshots that are swapped atomically,
+	// so attaching while other threads submit is safe and Submit takes no lock and touches
+	// no reference counts
+	//
+	// entries are counted by level and by the policy that rejected them, and each driver
+	// call is timed, all into counters sharded per thread (see GetStats)
 	class Channel : public IChannel
 	{
 	public:
@@ -27,8 +40,30 @@ namespace chil::log
 		void Flush() override;
 		void AttachDriver(std::shared_ptr<IDriver>) override;
 		void AttachPolicy(std::shared_ptr<IPolicy>) override;
+		bool AcceptsLevel(Level) const override;
+		ChannelStats GetStats() const override;
 	private:
-		std::vector<std::shared_ptr<IDriver>> driverPtrs_;
-		std::vector<std::shared_ptr<IPolicy>> policyPtrs_;
+		// types
+		struct Snapshot
+		{
+			std::vector<std::shared_ptr<IDriver>> driverPtrs;
+			std::vector<std::shared_ptr<IPolicy>> policyPtrs;
+			// parallel to the pointers above, and carried over into later snapshots
+			std::vector<std::shared_ptr<DriverMetrics>> driverMetricsPtrs;
+			std::vector<std::shared_ptr<ccr::ShardedCounter>> filteredPtrs;
+		};
+		// functions
+		// runs the entry through the policies from firstPolicy on, then the drivers
+		void Dispatch_(const Snapshot& snapshot, Entry& e, size_t firstPolicy);
+		template<typename F>
+		void Update_(F&& modify);
+		// data
+		std::atomic<const Snapshot*> pSnapshot_;
+		ccr::ShardedCounters<levelCount> submitted_;
+		// serializes writers; superseded snapshots are retired here rather than freed, since
+		// a reader may still be walking one, and live until the channel is destroyed
+		// (reconfiguration is rare, so this stays small)
+		std::mutex updateMtx_;
+		std::vector<std::unique_ptr<const Snapshot>> snapshotPtrs_;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "Clock.h"
+
+namespace chil::log
+{
+	namespace
+	{
+		struct Calibration
+		{
+			Clock::duration steady;
+			std::chrono::system_clock::time_point system;
+		};
+		const Calibration& GetCalibration()
+		{
+			// the wall-clock read is paired with the midpoint of two steady reads around it
+			static const Calibration calibration = [] {
+				const auto before = std::chrono::steady_clock::now();
+				const auto system = std::chrono::system_clock::now();
+				const auto after = std::chrono::steady_clock::now();
+				return Calibration{ before.time_since_epoch() + (after - before) / 2, system };
+			}();
+			return calibration;
+		}
+	}
+
+	void Clock::Calibrate()
+	{
+		GetCalibration();
+	}
+	std::chrono::system_clock::time_point Clock::ToSystem(time_point time)
+	{
+		const auto& calibration = GetCalibration();
+		return calibration.system + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+			time.time_since_epoch() - calibration.steady);
+	}
+	Clock::time_point Clock::FromSystem(std::chrono::system_clock::time_point time)
+	{
+		const auto& calibration = GetCalibration();
+		return time_point{ calibration.steady + std::chrono::duration_cast<duration>(time - calibration.system) };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include <chrono>
+
+namespace chil::log
+{
+	// clock for entry timestamps: a steady tick read on the hot path, converted to calendar
+	// time only where an entry is formatted or persisted. the steady/wall pairing is taken
+	// once per process (channels take it on construction, ahead of the first entry), so
+	// timestamps order entries across threads at the steady clock's resolution and an
+	// adjustment of the system clock mid-run does not reorder them; the flip side is that
+	// drift between the two clocks over a long run shows in the printed times
+	struct Clock
+	{
+		// types
+		using duration = std::chrono::steady_clock::duration;
+		using rep = duration::rep;
+		using period = duration::period;
+		using time_point = std::chrono::time_point<Clock>;
+		static constexpr bool is_steady = true;
+		// functions
+		static time_point now() noexcept
+		{
+			return time_point{ std::chrono::steady_clock::now().time_since_epoch() };
+		}
+		// takes the steady/wall pairing if it has not been taken yet
+		static void Calibrate();
+		static std::chrono::system_clock::time_point ToSystem(time_point time);
+		// for entries restored from persisted wall-clock times
+		static time_point FromSystem(std::chrono::system_clock::time_point time);
+	};
+}
\ No newline at end of file
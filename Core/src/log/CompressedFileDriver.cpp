@@ -0,0 +1,318 @@
+#include "CompressedFileDriver.h"
+#include "BinaryFormat.h"
+#include "CompressedFileFormat.h"
+#include "Entry.h"
+#include "Exception.h"
+#include "TextFormatter.h"
+#include <Core/src/utl/Lz.h>
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+namespace chil::log
+{
+	namespace
+	{
+		template<typename T>
+		bool ReadStruct(std::ifstream& file, T& value)
+		{
+			file.read(reinterpret_cast<char*>(&value), sizeof(value));
+			return file.gcount() == std::streamsize(sizeof(value));
+		}
+		// collects an index record for each block whose header and checksum are intact and
+		// returns where the last of them ends, or nothing when the file is not a compressed
+		// log; a crash can leave a torn block at the end of the file, and blocks appended
+		// after it would be unreachable, since nothing past the torn header can be told
+		// apart from garbage
+		std::optional<std::uint64_t> FindIntactBlocks(const std::filesystem::path& path, std::uint64_t size,
+			std::vector<compressed::IndexRecord>& blocks)
+		{
+			std::ifstream file{ path, std::ios::in | std::ios::binary };
+			compressed::Header header{};
+			if (!ReadStruct(file, header)) {
+				return 0;
+			}
+			if (std::memcmp(header.magic, compressed::magic, sizeof(header.magic)) != 0 ||
+				header.version != compressed::version) {
+				return std::nullopt;
+			}
+			std::uint64_t end = sizeof(header);
+			compressed::BlockHeader block{};
+			std::string data;
+			while (ReadStruct(file, block)) {
+				if (end + sizeof(block) + block.compressedSize > size) {
+					break;
+				}
+				data.resize(block.compressedSize);
+				file.read(data.data(), std::streamsize(data.size()));
+				if (file.gcount() != std::streamsize(data.size()) || block.checksum != bin::Checksum(data)) {
+					break;
+				}
+				blocks.push_back({
+					.offset = end,
+					.rawSize = block.rawSize,
+					.compressedSize = block.compressedSize,
+					.firstTimestamp = block.firstTimestamp,
+					.lastTimestamp = block.lastTimestamp,
+				});
+				end += sizeof(block) + block.compressedSize;
+			}
+			return end;
+		}
+		// number of leading index records that describe the given blocks, or nothing when
+		// the index is missing or not an index
+		std::optional<size_t> CountIndexed(const std::filesystem::path& indexPath,
+			const std::vector<compressed::IndexRecord>& blocks)
+		{
+			std::ifstream index{ indexPath, std::ios::in | std::ios::binary };
+			compressed::IndexHeader header{};
+			if (!ReadStruct(index, header) ||
+				std::memcmp(header.magic, compressed::indexMagic, sizeof(header.magic)) != 0 ||
+				header.version != compressed::version) {
+				return std::nullopt;
+			}
+			size_t count = 0;
+			compressed::IndexRecord record{};
+			while (count < blocks.size() && ReadStruct(index, record) &&
+				record.offset == blocks[count].offset && record.compressedSize == blocks[count].compressedSize) {
+				count++;
+			}
+			return count;
+		}
+		// cuts a torn tail off the data file before anything is appended to it, and the
+		// index back to the records that describe what is left; returns the records of
+		// intact blocks that the index lags behind, for the caller to append, so that new
+		// records follow on from the old ones instead of leaving a gap
+		std::vector<compressed::IndexRecord> RepairTail(const std::filesystem::path& path, const std::filesystem::path& indexPath)
+		{
+			std::error_code ec;
+			const auto size = std::filesystem::exists(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+			std::vector<compressed::IndexRecord> blocks;
+			const auto dataEnd = FindIntactBlocks(path, size, blocks);
+			// not a compressed log: left as it is
+			if (ec || !dataEnd) {
+				return {};
+			}
+			if (*dataEnd < size) {
+				std::filesystem::resize_file(path, *dataEnd, ec);
+				if (ec) {
+					throw DriverException{ L"Failed to trim torn block from log file " + path.wstring() };
+				}
+			}
+			// an unusable index is started over, so every block goes into the new one
+			const auto indexed = CountIndexed(indexPath, blocks);
+			const auto indexEnd = indexed ? sizeof(compressed::IndexHeader) + *indexed * sizeof(compressed::IndexRecord) : 0;
+			if (std::filesystem::exists(indexPath, ec) && std::filesystem::file_size(indexPath, ec) != indexEnd) {
+				std::filesystem::resize_file(indexPath, indexEnd, ec);
+				if (ec) {
+					throw DriverException{ L"Failed to trim log index " + indexPath.wstring() };
+				}
+			}
+			blocks.erase(blocks.begin(), blocks.begin() + indexed.value_or(0));
+			return blocks;
+		}
+		// opens for appending, writing the header when the file is new; returns the size
+		std::uint64_t OpenAppend(std::ofstream& file, const std::filesystem::path& path, const compressed::Header& header)
+		{
+			std::error_code ec;
+			const auto size = std::filesystem::exists(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+			file.open(path, std::ios::out | std::ios::app | std::ios::binary);
+			if (size == 0) {
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				return sizeof(header);
+			}
+			return size;
+		}
+	}
+
+	CompressedFileDriver::CompressedFileDriver(std::filesystem::path path, std::shared_ptr<ITextFormatter> pFormatter, Blocking blocking)
+		:
+		blocking_{ blocking },
+		pFormatter_{ std::move(pFormatter) }
+	{
+		// create any directories in the path that don't yet exist
+		std::filesystem::create_directories(path.parent_path());
+		compressed::Header header{ .version = compressed::version };
+		std::copy_n(compressed::magic, sizeof(header.magic), header.magic);
+		const auto unindexed = RepairTail(path, GetIndexPath(path));
+		offset_ = OpenAppend(file_, path, header);
+		std::copy_n(compressed::indexMagic, sizeof(header.magic), header.magic);
+		OpenAppend(index_, GetIndexPath(path), header);
+		for (const auto& record : unindexed) {
+			index_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+		}
+		if (!file_ || !index_) {
+			throw DriverException{ L"Failed to open log file " + path.wstring() };
+		}
+		compressorThread_ = std::thread{ &CompressedFileDriver::CompressorKernel_, this };
+	}
+	CompressedFileDriver::~CompressedFileDriver()
+	{
+		{
+			std::lock_guard lck{ mtx_ };
+			stopping_ = true;
+		}
+		wakeCv_.notify_one();
+		spaceCv_.notify_all();
+		compressorThread_.join();
+	}
+	void CompressedFileDriver::Submit(const Entry& e)
+	{
+		if (!pFormatter_) {
+			return;
+		}
+		thread_local std::string text;
+		text.clear();
+		pFormatter_->FormatUtf8To(text, e);
+		const auto timestamp = std::int64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			Clock::ToSystem(e.timestamp_).time_since_epoch()).count());
+
+		std::unique_lock lck{ mtx_ };
+		// bounded memory: wait for the compressor rather than queueing blocks without limit
+		spaceCv_.wait(lck, [this] { return pending_.size() < blocking_.maxPendingBlocks || stopping_; });
+		if (current_.entries == 0) {
+			currentStart_ = std::chrono::steady_clock::now();
+			current_.firstTimestamp = current_.lastTimestamp = timestamp;
+			if (current_.text.capacity() < blocking_.blockBytes) {
+				current_.text.reserve(blocking_.blockBytes + text.size());
+			}
+		}
+		current_.text += text;
+		current_.entries++;
+		// entries from different threads can arrive slightly out of order
+		current_.firstTimestamp = std::min(current_.firstTimestamp, timestamp);
+		current_.lastTimestamp = std::max(current_.lastTimestamp, timestamp);
+		stats_.entries++;
+		if (current_.text.size() >= blocking_.blockBytes) {
+			Seal_();
+			lck.unlock();
+			wakeCv_.notify_one();
+		}
+	}
+	void CompressedFileDriver::SetFormatter(std::shared_ptr<ITextFormatter> pFormatter)
+	{
+		pFormatter_ = std::move(pFormatter);
+	}
+	void CompressedFileDriver::Flush()
+	{
+		std::unique_lock lck{ mtx_ };
+		Seal_();
+		const auto ticket = ++flushRequested_;
+		wakeCv_.notify_one();
+		flushedCv_.wait(lck, [&] { return flushCompleted_ >= ticket || stopping_; });
+	}
+	CompressedFileDriver::Stats CompressedFileDriver::GetStats() const
+	{
+		std::lock_guard lck{ mtx_ };
+		return stats_;
+	}
+	std::uint64_t CompressedFileDriver::GetBytesWritten() const
+	{
+		return GetStats().compressedBytes;
+	}
+	std::filesystem::path CompressedFileDriver::GetIndexPath(const std::filesystem::path& path)
+	{
+		// logs/log.lz => logs/log.lz.idx
+		auto index = path;
+		index += ".idx";
+		return index;
+	}
+	void CompressedFileDriver::Seal_()
+	{
+		if (current_.entries == 0) {
+			return;
+		}
+		pending_.push_back(std::move(current_));
+		current_ = {};
+		current_.text = std::move(spare_);
+		current_.text.clear();
+	}
+	bool CompressedFileDriver::Write_(const Block& block)
+	{
+		compressed_.clear();
+		utl::LzCompress(block.text, compressed_);
+		const compressed::BlockHeader header{
+			.rawSize = std::uint32_t(block.text.size()),
+			.compressedSize = std::uint32_t(compressed_.size()),
+			.entryCount = std::uint32_t(block.entries),
+			.checksum = bin::Checksum(compressed_),
+			.firstTimestamp = block.firstTimestamp,
+			.lastTimestamp = block.lastTimestamp,
+		};
+		file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file_.write(compressed_.data(), std::streamsize(compressed_.size()));
+		if (!file_) {
+			// the stream position is unknown after a failed write, so later blocks are
+			// left unindexed; readers still find them by walking the headers
+			file_.clear();
+			indexing_ = false;
+			return false;
+		}
+		if (!indexing_) {
+			return true;
+		}
+		// the index entry is only written once the block is in the data file
+		const compressed::IndexRecord record{
+			.offset = offset_,
+			.rawSize = header.rawSize,
+			.compressedSize = header.compressedSize,
+			.firstTimestamp = header.firstTimestamp,
+			.lastTimestamp = header.lastTimestamp,
+		};
+		offset_ += sizeof(header) + compressed_.size();
+		index_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+		return true;
+	}
+	void CompressedFileDriver::CompressorKernel_()
+	{
+		std::unique_lock lck{ mtx_ };
+		while (true) {
+			// a partly filled block is sealed once it has been open for the seal interval;
+			// the wait is bounded so that a block started while idle is noticed
+			const auto deadline = (current_.entries ? currentStart_ : std::chrono::steady_clock::now())
+				+ blocking_.sealInterval;
+			wakeCv_.wait_until(lck, deadline, [this] {
+				return stopping_ || !pending_.empty() || flushRequested_ != flushCompleted_;
+			});
+			if (current_.entries && std::chrono::steady_clock::now() >= currentStart_ + blocking_.sealInterval) {
+				Seal_();
+			}
+			const bool stopping = stopping_;
+			if (stopping) {
+				Seal_();
+			}
+			const auto flushTicket = flushRequested_;
+			while (!pending_.empty()) {
+				auto block = std::move(pending_.front());
+				pending_.pop_front();
+				spaceCv_.notify_all();
+				lck.unlock();
+
+				const bool written = Write_(block);
+
+				lck.lock();
+				if (written) {
+					stats_.blocks++;
+					stats_.rawBytes += block.text.size();
+					stats_.compressedBytes += compressed_.size() + sizeof(compressed::BlockHeader);
+				}
+				else {
+					stats_.failedWrites++;
+				}
+				spare_ = std::move(block.text);
+			}
+			if (flushTicket != flushCompleted_ || stopping) {
+				lck.unlock();
+				file_.flush();
+				index_.flush();
+				lck.lock();
+				flushCompleted_ = flushTicket;
+				flushedCv_.notify_all();
+			}
+			if (stopping) {
+				break;
+			}
+		}
+	}
+}
\ No newline at end of file
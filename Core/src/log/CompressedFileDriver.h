@@ -0,0 +1,91 @@
+#pragma once
+#include "Driver.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace chil::log
+{
+	class ICompressedFileDriver : public ITextDriver {};
+
+	// text driver for high-volume logs: formatted UTF-8 text is gathered into fixed-size
+	// blocks that a background thread compresses and appends to the file, recording each
+	// block's position and time range in a sidecar index so that a reader can seek to a
+	// time and decompress only the blocks covering it (see CompressedFileFormat.h)
+	class CompressedFileDriver : public ICompressedFileDriver
+	{
+	public:
+		// types
+		struct Blocking
+		{
+			// uncompressed bytes that seal a block; larger blocks compress better but cost
+			// more to decompress for a lookup
+			size_t blockBytes = 1 << 20;
+			// longest time a partly filled block is held before it is sealed and written
+			std::chrono::milliseconds sealInterval{ 2000 };
+			// sealed blocks waiting for compression past which producers wait
+			size_t maxPendingBlocks = 8;
+		};
+		struct Stats
+		{
+			size_t entries = 0;
+			size_t blocks = 0;
+			size_t rawBytes = 0;
+			size_t compressedBytes = 0;
+			size_t failedWrites = 0;
+		};
+		// functions
+		CompressedFileDriver(std::filesystem::path path, std::shared_ptr<ITextFormatter> pFormatter = {}, Blocking blocking = {});
+		~CompressedFileDriver();
+		void Submit(const Entry&) override;
+		void SetFormatter(std::shared_ptr<ITextFormatter> pFormatter) override;
+		// seals the current block and blocks until everything submitted so far is written
+		void Flush() override;
+		Stats GetStats() const;
+		std::uint64_t GetBytesWritten() const override;
+		static std::filesystem::path GetIndexPath(const std::filesystem::path& path);
+	private:
+		// types
+		struct Block
+		{
+			std::string text;
+			size_t entries = 0;
+			std::int64_t firstTimestamp = 0;
+			std::int64_t lastTimestamp = 0;
+		};
+		// functions
+		void Seal_();
+		bool Write_(const Block& block);
+		void CompressorKernel_();
+		// data
+		Blocking blocking_;
+		std::shared_ptr<ITextFormatter> pFormatter_;
+		mutable std::mutex mtx_;
+		std::condition_variable wakeCv_;
+		std::condition_variable spaceCv_;
+		std::condition_variable flushedCv_;
+		Block current_;
+		std::chrono::steady_clock::time_point currentStart_;
+		std::deque<Block> pending_;
+		// text buffer of the last written block, handed back to producers for reuse
+		std::string spare_;
+		size_t flushRequested_ = 0;
+		size_t flushCompleted_ = 0;
+		Stats stats_;
+		bool stopping_ = false;
+		// owned by the compressor thread
+		std::ofstream file_;
+		std::ofstream index_;
+		std::uint64_t offset_ = 0;
+		bool indexing_ = true;
+		std::string compressed_;
+		std::thread compressorThread_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+
+// layout of CompressedFileDriver output, shared with CompressedFileReader
+//
+//   data file:  Header, then blocks of BlockHeader followed by compressedSize bytes
+//   index file: IndexHeader, then one IndexRecord per block, appended once the block is
+//               in the data file (<data file>.idx)
+//
+// a block holds whole formatted entries as UTF-8 text compressed with utl::LzCompress,
+// so each block decompresses on its own; timestamps are nanoseconds since the system
+// clock epoch, the earliest and latest of the entries in the block; the checksum
+// (bin::Checksum) covers the compressed bytes so that a block torn by a crash is detected,
+// and the driver cuts such a block off before appending to an existing file (filling in
+// any index records that did not reach the disk, so the index stays one unbroken chain)
+// the index is only an accelerator: a reader that finds it missing or behind the data
+// file walks the block headers instead
+namespace chil::log::compressed
+{
+	inline constexpr char magic[4] = { 'C', 'H', 'L', 'Z' };
+	inline constexpr char indexMagic[4] = { 'C', 'H', 'L', 'X' };
+	inline constexpr std::uint32_t version = 1;
+
+	struct Header
+	{
+		char magic[4];
+		std::uint32_t version;
+	};
+
+	struct BlockHeader
+	{
+		std::uint32_t rawSize;
+		std::uint32_t compressedSize;
+		std::uint32_t entryCount;
+		std::uint32_t checksum;
+		std::int64_t firstTimestamp;
+		std::int64_t lastTimestamp;
+	};
+
+	struct IndexRecord
+	{
+		// position of the BlockHeader in the data file
+		std::uint64_t offset;
+		std::uint32_t rawSize;
+		std::uint32_t compressedSize;
+		std::int64_t firstTimestamp;
+		std::int64_t lastTimestamp;
+	};
+
+	using IndexHeader = Header;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "CompressedFileReader.h"
+#include "BinaryFormat.h"
+#include "CompressedFileDriver.h"
+#include "CompressedFileFormat.h"
+#include <Core/src/utl/Lz.h>
+#include <algorithm>
+#include <cstring>
+
+namespace chil::log
+{
+	namespace
+	{
+		// corrupt sizes are rejected before they turn into huge allocations
+		constexpr std::uint32_t maxBlockSize = 1u << 30;
+
+		std::chrono::system_clock::time_point ToTimePoint(std::int64_t nanos)
+		{
+			return std::chrono::system_clock::time_point{
+				std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{ nanos })
+			};
+		}
+		template<typename T>
+		bool ReadStruct(std::ifstream& file, T& value)
+		{
+			file.read(reinterpret_cast<char*>(&value), sizeof(value));
+			return file.gcount() == std::streamsize(sizeof(value));
+		}
+		bool IsHeader(const compressed::Header& header, const char(&magic)[4])
+		{
+			return std::memcmp(header.magic, magic, sizeof(magic)) == 0 && header.version == compressed::version;
+		}
+	}
+
+	CompressedFileReader::CompressedFileReader(std::filesystem::path path)
+		:
+		file_{ path, std::ios::in | std::ios::binary }
+	{
+		compressed::Header header{};
+		if (!file_ || !ReadStruct(file_, header) || !IsHeader(header, compressed::magic)) {
+			return;
+		}
+		std::error_code ec;
+		fileSize_ = std::filesystem::file_size(path, ec);
+		valid_ = !ec;
+		if (valid_) {
+			ScanFrom_(LoadIndex_(CompressedFileDriver::GetIndexPath(path)));
+		}
+	}
+	bool CompressedFileReader::IsValid() const
+	{
+		return valid_;
+	}
+	std::span<const CompressedFileReader::Block> CompressedFileReader::GetBlocks() const
+	{
+		return blocks_;
+	}
+	std::vector<size_t> CompressedFileReader::FindBlocks(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) const
+	{
+		std::vector<size_t> indices;
+		for (size_t i = 0; i < blocks_.size(); i++) {
+			if (blocks_[i].last >= from && blocks_[i].first <= to) {
+				indices.push_back(i);
+			}
+		}
+		return indices;
+	}
+	bool CompressedFileReader::ReadBlock(size_t index, std::string& out)
+	{
+		if (index >= blocks_.size()) {
+			return false;
+		}
+		const auto& block = blocks_[index];
+		// the checksum lives in the block header, which the index does not repeat
+		compressed::BlockHeader header{};
+		file_.clear();
+		file_.seekg(std::streamoff(block.offset));
+		if (!ReadStruct(file_, header)) {
+			return false;
+		}
+		compressed_.resize(block.compressedSize);
+		file_.read(compressed_.data(), std::streamsize(compressed_.size()));
+		if (file_.gcount() != std::streamsize(compressed_.size()) || header.checksum != bin::Checksum(compressed_)) {
+			return false;
+		}
+		const auto start = out.size();
+		if (!utl::LzDecompress(compressed_, block.rawSize, out)) {
+			out.resize(start);
+			return false;
+		}
+		return true;
+	}
+	std::uint64_t CompressedFileReader::LoadIndex_(const std::filesystem::path& indexPath)
+	{
+		// index records are trusted only while they chain block to block within the data
+		// file; anything after the first mismatch is found by scanning instead
+		std::uint64_t next = sizeof(compressed::Header);
+		std::ifstream index{ indexPath, std::ios::in | std::ios::binary };
+		compressed::Header header{};
+		if (!index || !ReadStruct(index, header) || !IsHeader(header, compressed::indexMagic)) {
+			return next;
+		}
+		compressed::IndexRecord record{};
+		while (ReadStruct(index, record)) {
+			const auto end = record.offset + sizeof(compressed::BlockHeader) + record.compressedSize;
+			if (record.offset != next || end > fileSize_ ||
+				record.rawSize > maxBlockSize || record.compressedSize > maxBlockSize) {
+				break;
+			}
+			blocks_.push_back({
+				.offset = record.offset,
+				.rawSize = record.rawSize,
+				.compressedSize = record.compressedSize,
+				.first = ToTimePoint(record.firstTimestamp),
+				.last = ToTimePoint(record.lastTimestamp),
+			});
+			next = end;
+		}
+		return next;
+	}
+	void CompressedFileReader::ScanFrom_(std::uint64_t offset)
+	{
+		compressed::BlockHeader header{};
+		while (offset + sizeof(header) <= fileSize_) {
+			file_.clear();
+			file_.seekg(std::streamoff(offset));
+			if (!ReadStruct(file_, header)) {
+				break;
+			}
+			const auto end = offset + sizeof(header) + header.compressedSize;
+			// a block cut short by a crash ends the scan
+			if (end > fileSize_ || header.rawSize > maxBlockSize || header.compressedSize > maxBlockSize) {
+				break;
+			}
+			blocks_.push_back({
+				.offset = offset,
+				.rawSize = header.rawSize,
+				.compressedSize = header.compressedSize,
+				.first = ToTimePoint(header.firstTimestamp),
+				.last = ToTimePoint(header.lastTimestamp),
+			});
+			offset = end;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace chil::log
+{
+	// random access to the blocks of a CompressedFileDriver log; the block list comes from
+	// the sidecar index, with any blocks written after the last indexed one (or all of
+	// them, when the index is missing) found by walking the block headers
+	class CompressedFileReader
+	{
+	public:
+		// types
+		struct Block
+		{
+			std::uint64_t offset;
+			std::uint32_t rawSize;
+			std::uint32_t compressedSize;
+			std::chrono::system_clock::time_point first;
+			std::chrono::system_clock::time_point last;
+		};
+		// functions
+		CompressedFileReader(std::filesystem::path path);
+		// false when the file is missing or is not a compressed log
+		bool IsValid() const;
+		std::span<const Block> GetBlocks() const;
+		// indices of blocks whose time range overlaps [from, to]; blocks are checked
+		// individually since entries from several threads make ranges overlap slightly
+		std::vector<size_t> FindBlocks(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) const;
+		// appends the text of a block to out; false when the block fails validation
+		bool ReadBlock(size_t index, std::string& out);
+	private:
+		// functions
+		std::uint64_t LoadIndex_(const std::filesystem::path& indexPath);
+		void ScanFrom_(std::uint64_t offset);
+		// data
+		std::ifstream file_;
+		std::uint64_t fileSize_ = 0;
+		bool valid_ = false;
+		std::vector<Block> blocks_;
+		std::string compressed_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "DeferredNote.h"
+#include <algorithm>
+#include <iterator>
+
+namespace chil::log
+{
+	DeferredNote::DeferredNote(std::wstring_view format, std::span<const Arg> args)
+		:
+		format_{ format },
+		count_{ std::min(args.size(), args_.size()) }
+	{
+		std::copy_n(args.begin(), count_, args_.begin());
+	}
+	std::wstring_view DeferredNote::GetFormat() const
+	{
+		return format_;
+	}
+	std::span<const DeferredNote::Arg> DeferredNote::GetArgs() const
+	{
+		return { args_.data(), count_ };
+	}
+	template<size_t...I>
+	void DeferredNote::ExpandTo_(std::wstring& out, std::index_sequence<I...>) const
+	{
+		std::vformat_to(std::back_inserter(out), format_, std::make_wformat_args(args_[I]...));
+	}
+	void DeferredNote::ExpandTo(std::wstring& out) const
+	{
+		try {
+			switch (count_) {
+			case 0: ExpandTo_(out, std::make_index_sequence<0>{}); break;
+			case 1: ExpandTo_(out, std::make_index_sequence<1>{}); break;
+			case 2: ExpandTo_(out, std::make_index_sequence<2>{}); break;
+			case 3: ExpandTo_(out, std::make_index_sequence<3>{}); break;
+			case 4: ExpandTo_(out, std::make_index_sequence<4>{}); break;
+			case 5: ExpandTo_(out, std::make_index_sequence<5>{}); break;
+			case 6: ExpandTo_(out, std::make_index_sequence<6>{}); break;
+			case 7: ExpandTo_(out, std::make_index_sequence<7>{}); break;
+			default: ExpandTo_(out, std::make_index_sequence<8>{}); break;
+			}
+		}
+		catch (const std::format_error&) {
+			// keep the raw format rather than losing the entry
+			out += format_;
+		}
+	}
+	std::wstring DeferredNote::Expand() const
+	{
+		std::wstring text;
+		ExpandTo(text);
+		return text;
+	}
+}
\ No newline at end of file
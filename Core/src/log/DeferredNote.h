@@ -0,0 +1,138 @@
+#pragma once
+#include <array>
+#include <concepts>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace chil::log
+{
+	// note stored as a compile-time format string plus a copy of its arguments, expanded
+	// only when a driver actually needs text; arguments are normalized to a handful of
+	// kinds so that non-text drivers can persist them as-is
+	class DeferredNote
+	{
+	public:
+		// types
+		enum class Kind : unsigned char
+		{
+			Signed,
+			Unsigned,
+			Float,
+			Bool,
+			Char,
+		};
+		union Value
+		{
+			long long i;
+			unsigned long long u;
+			double f;
+			bool b;
+			wchar_t c;
+		};
+		struct Arg
+		{
+			Kind kind;
+			Value value;
+		};
+		template<typename T>
+		static constexpr bool IsDeferrable = std::integral<std::remove_cvref_t<T>> ||
+			std::floating_point<std::remove_cvref_t<T>>;
+		template<typename...A>
+		static constexpr bool Accepts = sizeof...(A) <= 8 && (IsDeferrable<A> && ...);
+		// functions
+		DeferredNote() = default;
+		// format must have static storage duration (a literal, as given to std::wformat_string)
+		template<typename...A> requires Accepts<A...>
+		DeferredNote(std::wstring_view format, const A&...args)
+			:
+			format_{ format },
+			count_{ sizeof...(A) },
+			args_{ MakeArg(args)... }
+		{}
+		// restore a note from persisted parts (offline decoding)
+		DeferredNote(std::wstring_view format, std::span<const Arg> args);
+		std::wstring_view GetFormat() const;
+		std::span<const Arg> GetArgs() const;
+		// append expanded text to out
+		void ExpandTo(std::wstring& out) const;
+		std::wstring Expand() const;
+		// normalizes one deferrable value (also used for structured fields)
+		template<typename T>
+		static constexpr Arg MakeArg(const T& v)
+		{
+			using U = std::remove_cvref_t<T>;
+			if constexpr (std::same_as<U, bool>) {
+				return { .kind = Kind::Bool, .value = { .b = v } };
+			}
+			else if constexpr (std::same_as<U, wchar_t> || std::same_as<U, char>) {
+				return { .kind = Kind::Char, .value = { .c = (wchar_t)v } };
+			}
+			else if constexpr (std::floating_point<U>) {
+				return { .kind = Kind::Float, .value = { .f = (double)v } };
+			}
+			else if constexpr (std::signed_integral<U>) {
+				return { .kind = Kind::Signed, .value = { .i = (long long)v } };
+			}
+			else {
+				return { .kind = Kind::Unsigned, .value = { .u = (unsigned long long)v } };
+			}
+		}
+	private:
+		// functions
+		template<size_t...I>
+		void ExpandTo_(std::wstring& out, std::index_sequence<I...>) const;
+		// data
+		std::wstring_view format_;
+		size_t count_ = 0;
+		std::array<Arg, 8> args_{};
+	};
+}
+
+// formats a deferred argument with the spec that was written for its original type
+template<>
+struct std::formatter<chil::log::DeferredNote::Arg, wchar_t>
+{
+	constexpr auto parse(std::wformat_parse_context& ctx)
+	{
+		auto it = ctx.begin();
+		int depth = 0;
+		while (it != ctx.end() && (*it != L'}' || depth > 0)) {
+			if (*it == L'{') {
+				depth++;
+			}
+			else if (*it == L'}') {
+				depth--;
+			}
+			++it;
+		}
+		spec_ = std::wstring_view{ ctx.begin(), it };
+		return it;
+	}
+	template<typename FormatContext>
+	auto format(const chil::log::DeferredNote::Arg& arg, FormatContext& ctx) const
+	{
+		using Kind = chil::log::DeferredNote::Kind;
+		switch (arg.kind) {
+		case Kind::Signed: return FormatAs_(arg.value.i, ctx);
+		case Kind::Unsigned: return FormatAs_(arg.value.u, ctx);
+		case Kind::Float: return FormatAs_(arg.value.f, ctx);
+		case Kind::Bool: return FormatAs_(arg.value.b, ctx);
+		default: return FormatAs_(arg.value.c, ctx);
+		}
+	}
+private:
+	// nested replacement fields (dynamic width/precision) are not supported here and
+	// surface as std::format_error
+	template<typename T, typename FormatContext>
+	auto FormatAs_(const T& value, FormatContext& ctx) const
+	{
+		std::formatter<T, wchar_t> formatter;
+		std::wformat_parse_context parseContext{ spec_ };
+		formatter.parse(parseContext);
+		return formatter.format(value, ctx);
+	}
+	std::wstring_view spec_;
+};
\ No newline at end of file
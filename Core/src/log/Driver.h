@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 
 namespace chil::log
@@ -12,6 +13,8 @@ namespace chil::log
 		virtual ~IDriver() = default;
 		virtual void Submit(const Entry&) = 0;
 		virtual void Flush() = 0;
+		// bytes written to the driver's sink so far, for drivers that count them
+		virtual std::uint64_t GetBytesWritten() const { return 0; }
 	};
 
 	class ITextDriver : public IDriver
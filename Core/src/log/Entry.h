@@ -1,5 +1,9 @@
 #pragma once
+#include "Clock.h"
 #include "Level.h"
+#include "DeferredNote.h"
+#include "Fields.h"
+#include "Site.h"
 #include <chrono>
 #include <optional>
 #include <Core/src/utl/StackTrace.h>
@@ -11,10 +15,12 @@ namespace chil::log
 		// data fields 
 		Level level_ = Level::Error;
 		std::wstring note_;
-		const wchar_t* sourceFile_ = nullptr;
-		const wchar_t* sourceFunctionName_ = nullptr;
-		int sourceLine_ = -1;
-		std::chrono::system_clock::time_point timestamp_;
+		// UTF-8 note; takes the place of note_ when not empty
+		std::u8string noteUtf8_;
+		std::optional<DeferredNote> deferredNote_;
+		std::optional<Fields> fields_;
+		const Site* pSite_ = nullptr;
+		Clock::time_point timestamp_;
 		std::optional<utl::StackTrace> trace_;
 		std::optional<unsigned int> hResult_;
 		// behavior override flags 
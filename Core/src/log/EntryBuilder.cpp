@@ -8,18 +8,24 @@
 // positive on some functions returning *this (not consistent or clear or correct) 
 namespace chil::log
 {
-	EntryBuilder::EntryBuilder(const wchar_t* sourceFile, const wchar_t* sourceFunctionName, int sourceLine)
+	EntryBuilder::EntryBuilder(const Site& site)
 		:
 		Entry{
-			.sourceFile_ = sourceFile,
-			.sourceFunctionName_ = sourceFunctionName,
-			.sourceLine_ = sourceLine,
-			.timestamp_ = std::chrono::system_clock::now(),
+			.level_ = site.GetLevel(),
+			.pSite_ = &site,
+			.timestamp_ = Clock::now(),
 		}
 	{}
+	EntryBuilder::EntryBuilder(const wchar_t* sourceFile, const wchar_t* sourceFunctionName, int sourceLine)
+		:
+		EntryBuilder{ InternSite(sourceFile, sourceFunctionName, sourceLine) }
+	{}
 	EntryBuilder& EntryBuilder::note(std::wstring note)
 	{
+		// the last note set wins, whatever its kind
 		note_ = std::move(note);
+		noteUtf8_.clear();
+		deferredNote_.reset();
 		return *this;
 	}
 	EntryBuilder& EntryBuilder::level(Level level)
@@ -29,38 +35,65 @@ namespace chil::log
 	}
 	EntryBuilder& EntryBuilder::verbose(std::wstring note)
 	{
-		note_ = std::move(note);
-		level_ = Level::Verbose;
-		return *this;
+		return level(Level::Verbose).note(std::move(note));
 	}
 	EntryBuilder& EntryBuilder::debug(std::wstring note)
 	{
-		note_ = std::move(note);
-		level_ = Level::Debug;
-		return *this;
+		return level(Level::Debug).note(std::move(note));
 	}
 	EntryBuilder& EntryBuilder::info(std::wstring note)
 	{
-		note_ = std::move(note);
-		level_ = Level::Info;
-		return *this;
+		return level(Level::Info).note(std::move(note));
 	}
 	EntryBuilder& EntryBuilder::warn(std::wstring note)
 	{
-		note_ = std::move(note);
-		level_ = Level::Warn;
-		return *this;
+		return level(Level::Warn).note(std::move(note));
 	}
 	EntryBuilder& EntryBuilder::error(std::wstring note)
 	{
-		note_ = std::move(note);
-		level_ = Level::Error;
-		return *this;
+		return level(Level::Error).note(std::move(note));
 	}
 	EntryBuilder& EntryBuilder::fatal(std::wstring note)
 	{
-		note_ = std::move(note);
-		level_ = Level::Fatal;
+		return level(Level::Fatal).note(std::move(note));
+	}
+	EntryBuilder& EntryBuilder::note(std::u8string_view note)
+	{
+		noteUtf8_ = note;
+		note_.clear();
+		deferredNote_.reset();
+		return *this;
+	}
+	EntryBuilder& EntryBuilder::verbose(std::u8string_view note)
+	{
+		return level(Level::Verbose).note(note);
+	}
+	EntryBuilder& EntryBuilder::debug(std::u8string_view note)
+	{
+		return level(Level::Debug).note(note);
+	}
+	EntryBuilder& EntryBuilder::info(std::u8string_view note)
+	{
+		return level(Level::Info).note(note);
+	}
+	EntryBuilder& EntryBuilder::warn(std::u8string_view note)
+	{
+		return level(Level::Warn).note(note);
+	}
+	EntryBuilder& EntryBuilder::error(std::u8string_view note)
+	{
+		return level(Level::Error).note(note);
+	}
+	EntryBuilder& EntryBuilder::fatal(std::u8string_view note)
+	{
+		return level(Level::Fatal).note(note);
+	}
+	EntryBuilder& EntryBuilder::field(std::wstring_view key, std::wstring_view text)
+	{
+		if (!fields_) {
+			fields_.emplace();
+		}
+		fields_->Add(key, text);
 		return *this;
 	}
 	EntryBuilder& EntryBuilder::chan(IChannel* pChan)
@@ -105,7 +138,7 @@ namespace chil::log
 	}
 	EntryBuilder::~EntryBuilder()
 	{
-		if (pDest_) {
+		if (pDest_ && pSite_->IsEnabled()) {
 			if (captureTrace_.value_or((int)level_ <= (int)Level::Error)) {
 				trace_.emplace(traceSkipDepth_);
 			}
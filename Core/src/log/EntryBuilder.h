@@ -1,5 +1,6 @@
 #pragma once
 #include "Entry.h"
+#include <format>
 
 namespace chil::log
 {
@@ -8,6 +9,8 @@ namespace chil::log
 	class EntryBuilder : private Entry
 	{
 	public:
+		EntryBuilder(const Site& site);
+		// for locations that are not literal call sites; interns a site under a lock
 		EntryBuilder(const wchar_t* sourceFile, const wchar_t* sourceFunctionName, int sourceLine);
 		EntryBuilder& note(std::wstring note);
 		EntryBuilder& level(Level);
@@ -17,6 +20,71 @@ namespace chil::log
 		EntryBuilder& warn(std::wstring note = L"");
 		EntryBuilder& error(std::wstring note = L"");
 		EntryBuilder& fatal(std::wstring note = L"");
+		// UTF-8 notes, kept as UTF-8 all the way to byte-oriented drivers
+		EntryBuilder& note(std::u8string_view note);
+		EntryBuilder& verbose(std::u8string_view note);
+		EntryBuilder& debug(std::u8string_view note);
+		EntryBuilder& info(std::u8string_view note);
+		EntryBuilder& warn(std::u8string_view note);
+		EntryBuilder& error(std::u8string_view note);
+		EntryBuilder& fatal(std::u8string_view note);
+		// formatted notes; when every argument is a plain arithmetic value the format and
+		// arguments are stored and only expanded if a text driver consumes the entry
+		template<typename...A> requires (sizeof...(A) > 0)
+		EntryBuilder& note(std::wformat_string<A...> fmt, A&&...args)
+		{
+			noteUtf8_.clear();
+			if constexpr (DeferredNote::Accepts<A...>) {
+				deferredNote_.emplace(fmt.get(), args...);
+				note_.clear();
+			}
+			else {
+				note_ = std::format(fmt, std::forward<A>(args)...);
+				deferredNote_.reset();
+			}
+			return *this;
+		}
+		template<typename...A> requires (sizeof...(A) > 0)
+		EntryBuilder& verbose(std::wformat_string<A...> fmt, A&&...args)
+		{
+			return level(Level::Verbose).note(fmt, std::forward<A>(args)...);
+		}
+		template<typename...A> requires (sizeof...(A) > 0)
+		EntryBuilder& debug(std::wformat_string<A...> fmt, A&&...args)
+		{
+			return level(Level::Debug).note(fmt, std::forward<A>(args)...);
+		}
+		template<typename...A> requires (sizeof...(A) > 0)
+		EntryBuilder& info(std::wformat_string<A...> fmt, A&&...args)
+		{
+			return level(Level::Info).note(fmt, std::forward<A>(args)...);
+		}
+		template<typename...A> requires (sizeof...(A) > 0)
+		EntryBuilder& warn(std::wformat_string<A...> fmt, A&&...args)
+		{
+			return level(Level::Warn).note(fmt, std::forward<A>(args)...);
+		}
+		template<typename...A> requires (sizeof...(A) > 0)
+		EntryBuilder& error(std::wformat_string<A...> fmt, A&&...args)
+		{
+			return level(Level::Error).note(fmt, std::forward<A>(args)...);
+		}
+		template<typename...A> requires (sizeof...(A) > 0)
+		EntryBuilder& fatal(std::wformat_string<A...> fmt, A&&...args)
+		{
+			return level(Level::Fatal).note(fmt, std::forward<A>(args)...);
+		}
+		// structured key/value pairs, kept alongside the note; keys must be literals
+		template<typename T> requires DeferredNote::IsDeferrable<T>
+		EntryBuilder& field(std::wstring_view key, const T& value)
+		{
+			if (!fields_) {
+				fields_.emplace();
+			}
+			fields_->Add(key, value);
+			return *this;
+		}
+		EntryBuilder& field(std::wstring_view key, std::wstring_view text);
 		EntryBuilder& chan(IChannel*);
 		EntryBuilder& trace_skip(int depth);
 		EntryBuilder& no_trace();
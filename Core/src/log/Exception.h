@@ -0,0 +1,7 @@
+#pragma once 
+#include <Core/src/utl/Exception.h> 
+
+namespace chil::log
+{
+	ZC_EX_DEF(DriverException);
+}
\ No newline at end of file
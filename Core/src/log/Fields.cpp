@@ -0,0 +1,78 @@
+#include "Fields.h"
+#include <Core/src/ccr/PoolAllocator.h>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+namespace chil::log
+{
+	namespace
+	{
+		// blocks are handed back without running a destructor
+		template<typename T>
+			requires std::is_trivially_destructible_v<T>
+		using StoragePool = ccr::BlockPool<sizeof(T), alignof(T)>;
+	}
+
+	Fields::Fields(const Fields& other)
+	{
+		*this = other;
+	}
+	Fields& Fields::operator=(const Fields& other)
+	{
+		if (this == &other) {
+			return *this;
+		}
+		if (!other.pStorage_) {
+			pStorage_.reset();
+		}
+		else {
+			GetStorage_() = *other.pStorage_;
+		}
+		return *this;
+	}
+	bool Fields::Add(std::wstring_view key, std::wstring_view text)
+	{
+		auto& storage = GetStorage_();
+		if (storage.count >= capacity) {
+			return false;
+		}
+		const auto size = std::min(text.size(), textCapacity - storage.textSize);
+		std::copy_n(text.begin(), size, storage.text.begin() + storage.textSize);
+		storage.fields[storage.count++] = {
+			.key = key,
+			.value = {},
+			.isText = true,
+			.textOffset = (unsigned short)storage.textSize,
+			.textSize = (unsigned short)size,
+		};
+		storage.textSize += size;
+		return size == text.size();
+	}
+	std::span<const Fields::Field> Fields::Get() const
+	{
+		if (!pStorage_) {
+			return {};
+		}
+		return { pStorage_->fields.data(), pStorage_->count };
+	}
+	std::wstring_view Fields::GetText(const Field& field) const
+	{
+		return { pStorage_->text.data() + field.textOffset, field.textSize };
+	}
+	bool Fields::IsEmpty() const
+	{
+		return !pStorage_ || pStorage_->count == 0;
+	}
+	Fields::Storage& Fields::GetStorage_()
+	{
+		if (!pStorage_) {
+			pStorage_.reset(::new (StoragePool<Storage>::Allocate()) Storage{});
+		}
+		return *pStorage_;
+	}
+	void Fields::StorageDeleter::operator()(Storage* pStorage) const noexcept
+	{
+		StoragePool<Storage>::Deallocate(pStorage);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include "DeferredNote.h"
+#include <array>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace chil::log
+{
+	// typed key/value pairs attached to an entry; arithmetic values use the deferred note
+	// representation, text values are copied into a small character buffer. the pairs live
+	// in a fixed-size block taken from a pool on the first Add, so an entry without fields
+	// carries a single null pointer, and one with fields costs no heap allocation once the
+	// pool has warmed up (copies get a block of their own)
+	class Fields
+	{
+	public:
+		// types
+		struct Field
+		{
+			// must have static storage duration (a literal), like deferred formats
+			std::wstring_view key;
+			// arithmetic value; unused when the field holds text
+			DeferredNote::Arg value;
+			bool isText;
+			// location of the text in the owning Fields' character buffer
+			unsigned short textOffset;
+			unsigned short textSize;
+		};
+		// functions
+		Fields() = default;
+		Fields(const Fields&);
+		Fields& operator=(const Fields&);
+		Fields(Fields&&) noexcept = default;
+		Fields& operator=(Fields&&) noexcept = default;
+		// fields past capacity are dropped, text past the buffer is truncated; both return false
+		template<typename T> requires DeferredNote::IsDeferrable<T>
+		bool Add(std::wstring_view key, const T& value)
+		{
+			auto& storage = GetStorage_();
+			if (storage.count >= capacity) {
+				return false;
+			}
+			storage.fields[storage.count++] = { .key = key, .value = DeferredNote::MakeArg(value), .isText = false };
+			return true;
+		}
+		bool Add(std::wstring_view key, std::wstring_view text);
+		std::span<const Field> Get() const;
+		std::wstring_view GetText(const Field& field) const;
+		bool IsEmpty() const;
+		// data
+		static constexpr size_t capacity = 8;
+		static constexpr size_t textCapacity = 128;
+	private:
+		// types
+		struct Storage
+		{
+			size_t count = 0;
+			size_t textSize = 0;
+			std::array<Field, capacity> fields{};
+			std::array<wchar_t, textCapacity> text{};
+		};
+		struct StorageDeleter
+		{
+			void operator()(Storage* pStorage) const noexcept;
+		};
+		// functions
+		Storage& GetStorage_();
+		// data
+		std::unique_ptr<Storage, StorageDeleter> pStorage_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "FlightRecorderDriver.h"
+#include "FlightRecorderFormat.h"
+#include "Entry.h"
+#include "Exception.h"
+#include <Core/src/utl/String.h>
+#include <Core/src/win/ChilWin.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <format>
+
+namespace chil::log
+{
+	namespace
+	{
+		// encodes e into record; the note is cut to noteLimit bytes, and a deferred note is
+		// written expanded when expand is set
+		void EncodeRecord(std::string& record, const Entry& e, bool expand, size_t noteLimit)
+		{
+			thread_local std::string text;
+			thread_local std::wstring wide;
+			const bool deferred = e.deferredNote_ && !expand;
+			std::uint8_t flags = 0;
+			if (e.hResult_) {
+				flags |= bin::HasHResult;
+			}
+			if (deferred) {
+				flags |= bin::HasDeferredNote;
+			}
+			if (e.showSourceLine_) {
+				flags |= *e.showSourceLine_ ? bin::ShowSourceLine : bin::HideSourceLine;
+			}
+			record.clear();
+			record.push_back(char(e.level_));
+			record.push_back(char(flags));
+			bin::PutSigned(record, std::chrono::duration_cast<std::chrono::nanoseconds>(
+				Clock::ToSystem(e.timestamp_).time_since_epoch()).count());
+			bin::PutSigned(record, e.pSite_ ? e.pSite_->GetLine() : -1);
+			if (e.hResult_) {
+				bin::PutU32(record, *e.hResult_);
+			}
+			text.clear();
+			utl::AppendUtf8(text, e.pSite_ && e.pSite_->GetFile() ? e.pSite_->GetFile() : L"");
+			bin::PutBytes(record, text);
+			text.clear();
+			utl::AppendUtf8(text, e.pSite_ && e.pSite_->GetFunction() ? e.pSite_->GetFunction() : L"");
+			bin::PutBytes(record, text);
+			text.clear();
+			if (deferred) {
+				utl::AppendUtf8(text, e.deferredNote_->GetFormat());
+				bin::PutBytes(record, text);
+				bin::PutArgs(record, e.deferredNote_->GetArgs());
+			}
+			else {
+				if (e.deferredNote_) {
+					wide.clear();
+					e.deferredNote_->ExpandTo(wide);
+					utl::AppendUtf8(text, wide);
+				}
+				else if (!e.noteUtf8_.empty()) {
+					text += utl::AsChars(e.noteUtf8_);
+				}
+				else {
+					utl::AppendUtf8(text, e.note_);
+				}
+				// a cut in the middle of a multi-byte sequence decodes as a replacement char
+				if (text.size() > noteLimit) {
+					text.resize(noteLimit);
+				}
+				bin::PutBytes(record, text);
+			}
+		}
+	}
+
+	FlightRecorderDriver::FlightRecorderDriver(std::filesystem::path path, size_t slotCount, size_t slotSize)
+		:
+		slotCount_{ std::max<size_t>(slotCount, 1) },
+		slotSize_{ std::max<size_t>((slotSize + 7) & ~size_t(7), 64) }
+	{
+		// create any directories in the path that don't yet exist
+		std::filesystem::create_directories(path.parent_path());
+		// keep the previous run's ring for post-mortem, since it is what we are here for
+		if (std::filesystem::exists(path)) {
+			auto prev = path;
+			prev.replace_filename(path.stem().wstring() + L".prev" + path.extension().wstring());
+			std::error_code ec;
+			std::filesystem::remove(prev, ec);
+			std::filesystem::rename(path, prev, ec);
+		}
+		viewSize_ = flight::headerSize + slotCount_ * slotSize_;
+		const auto hFile = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+			nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (hFile == INVALID_HANDLE_VALUE) {
+			throw DriverException{ L"Failed to open flight recorder file " + path.wstring() };
+		}
+		hFile_ = hFile;
+		// mapping a new file at this size extends it with zeros, so all slots start empty
+		hMapping_ = CreateFileMappingW(hFile, nullptr, PAGE_READWRITE,
+			DWORD(std::uint64_t(viewSize_) >> 32), DWORD(viewSize_), nullptr);
+		if (hMapping_) {
+			pView_ = static_cast<char*>(MapViewOfFile(hMapping_, FILE_MAP_WRITE, 0, 0, viewSize_));
+		}
+		if (!pView_) {
+			if (hMapping_) {
+				CloseHandle(hMapping_);
+			}
+			CloseHandle(hFile_);
+			throw DriverException{ L"Failed to map flight recorder file " + path.wstring() };
+		}
+		auto& header = *reinterpret_cast<flight::Header*>(pView_);
+		std::memcpy(header.magic, flight::magic, sizeof(header.magic));
+		header.version = flight::version;
+		header.slotSize = std::uint32_t(slotSize_);
+		header.slotCount = std::uint32_t(slotCount_);
+		header.next = 0;
+	}
+	FlightRecorderDriver::~FlightRecorderDriver()
+	{
+		UnmapViewOfFile(pView_);
+		CloseHandle(hMapping_);
+		CloseHandle(hFile_);
+	}
+	void FlightRecorderDriver::Submit(const Entry& e)
+	{
+		thread_local std::string record;
+		const auto capacity = slotSize_ - flight::slotHeaderSize;
+		EncodeRecord(record, e, false, capacity);
+		if (record.size() > capacity) {
+			// fall back to expanded text cut to the room left by the fixed part; the margin
+			// covers the note's length prefix growing past one byte
+			EncodeRecord(record, e, true, 0);
+			const auto room = capacity > record.size() + 3 ? capacity - record.size() - 3 : 0;
+			EncodeRecord(record, e, true, room);
+			if (record.size() > capacity) {
+				// source strings alone overflow the slot; slots are sized too small
+				return;
+			}
+		}
+
+		auto& header = *reinterpret_cast<flight::Header*>(pView_);
+		const auto position = std::atomic_ref{ header.next }.fetch_add(1, std::memory_order_relaxed);
+		char* const pSlot = pView_ + flight::headerSize + (position % slotCount_) * slotSize_;
+		auto& slot = *reinterpret_cast<flight::SlotHeader*>(pSlot);
+		// invalidate, fill, then publish; a reader of a crashed file trusts only slots whose
+		// checksum matches
+		std::atomic_ref sequence{ slot.sequence };
+		sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(pSlot + flight::slotHeaderSize, record.data(), record.size());
+		slot.size = std::uint32_t(record.size());
+		slot.checksum = bin::Checksum(record);
+		sequence.store(position + 1, std::memory_order_release);
+		bytesWritten_.Add(0, record.size());
+	}
+	void FlightRecorderDriver::Flush()
+	{
+		FlushViewOfFile(pView_, viewSize_);
+	}
+	std::uint64_t FlightRecorderDriver::GetBytesWritten() const
+	{
+		return bytesWritten_.Get(0);
+	}
+}
\ No newline at end of file
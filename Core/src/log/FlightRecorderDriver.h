@@ -0,0 +1,39 @@
+#pragma once
+#include "Driver.h"
+#include <Core/src/ccr/ShardedCounters.h>
+#include <filesystem>
+
+namespace chil::log
+{
+	class IFlightRecorderDriver : public IDriver {};
+
+	// keeps the most recent entries in a fixed ring of slots inside a memory-mapped file;
+	// a slot is written with plain stores into the mapping, so an entry survives a crash or
+	// a kill as soon as Submit returns, without any per-entry system call
+	//
+	// each slot holds one self-contained record (see FlightRecorderFormat.h); records that
+	// do not fit have their note truncated. the ring from the previous run is kept next to
+	// the file as <stem>.prev<ext>
+	class FlightRecorderDriver : public IFlightRecorderDriver
+	{
+	public:
+		FlightRecorderDriver(std::filesystem::path path, size_t slotCount = 4096, size_t slotSize = 512);
+		~FlightRecorderDriver();
+		FlightRecorderDriver(const FlightRecorderDriver&) = delete;
+		FlightRecorderDriver& operator=(const FlightRecorderDriver&) = delete;
+		void Submit(const Entry&) override;
+		// asks the OS to write dirty pages out (only matters for surviving an OS crash)
+		void Flush() override;
+		std::uint64_t GetBytesWritten() const override;
+	private:
+		// HANDLEs, kept opaque so that the header does not pull in Windows.h
+		void* hFile_ = nullptr;
+		void* hMapping_ = nullptr;
+		char* pView_ = nullptr;
+		size_t viewSize_ = 0;
+		size_t slotCount_;
+		size_t slotSize_;
+		// Submit runs on any number of threads at once
+		ccr::ShardedCounter bytesWritten_;
+	};
+}
\ No newline at end of file
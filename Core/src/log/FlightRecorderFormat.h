@@ -0,0 +1,39 @@
+#pragma once
+#include "BinaryFormat.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// layout of the FlightRecorderDriver ring file, shared with FlightRecorderReader
+//
+//   Header (64 bytes) then slotCount slots of slotSize bytes each
+//   Slot: sequence:u64 size:u32 checksum:u32 record[size]
+//   Record: level flags timestamp line [hr:u32] file function (format args | note)
+//
+// flags are bin::EntryFlags and strings/args use the bin:: encodings; a slot's sequence is
+// 1 + the ring position it was written for, 0 while it is being written; the checksum
+// covers the record so that a slot torn by a crash is detected
+namespace chil::log::flight
+{
+	inline constexpr char magic[4] = { 'C', 'H', 'L', 'F' };
+	inline constexpr std::uint32_t version = 1;
+	inline constexpr size_t headerSize = 64;
+	inline constexpr size_t slotHeaderSize = 16;
+
+	struct Header
+	{
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t slotSize;
+		std::uint32_t slotCount;
+		// next ring position to claim, advanced atomically by writers
+		std::uint64_t next;
+	};
+
+	struct SlotHeader
+	{
+		std::uint64_t sequence;
+		std::uint32_t size;
+		std::uint32_t checksum;
+	};
+}
\ No newline at end of file
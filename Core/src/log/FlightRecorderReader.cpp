@@ -0,0 +1,127 @@
+#include "FlightRecorderReader.h"
+#include "FlightRecorderFormat.h"
+#include <Core/src/utl/String.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace chil::log
+{
+	FlightRecorderReader::SiteRecord::SiteRecord(std::wstring fileName, std::wstring functionName, int line)
+		:
+		file{ std::move(fileName) },
+		function{ std::move(functionName) },
+		site{ file.c_str(), function.c_str(), line }
+	{}
+
+	FlightRecorderReader::FlightRecorderReader(std::filesystem::path path)
+	{
+		std::ifstream file{ path, std::ios::in | std::ios::binary };
+		const std::string data{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+		if (data.size() < flight::headerSize) {
+			return;
+		}
+		flight::Header header;
+		std::memcpy(&header, data.data(), sizeof(header));
+		if (std::memcmp(header.magic, flight::magic, sizeof(header.magic)) != 0 ||
+			header.version != flight::version || header.slotSize <= flight::slotHeaderSize ||
+			data.size() < flight::headerSize + size_t(header.slotCount) * header.slotSize) {
+			return;
+		}
+		valid_ = true;
+		// collect published slots and order them by the position they were written for
+		std::vector<std::pair<std::uint64_t, std::string_view>> slots;
+		for (size_t i = 0; i < header.slotCount; i++) {
+			const char* const pSlot = data.data() + flight::headerSize + i * header.slotSize;
+			flight::SlotHeader slot;
+			std::memcpy(&slot, pSlot, sizeof(slot));
+			if (slot.sequence == 0 && slot.size == 0) {
+				continue;
+			}
+			const std::string_view record{ pSlot + flight::slotHeaderSize,
+				std::min<size_t>(slot.size, header.slotSize - flight::slotHeaderSize) };
+			if (slot.sequence == 0 || record.size() != slot.size || bin::Checksum(record) != slot.checksum) {
+				discarded_++;
+				continue;
+			}
+			slots.emplace_back(slot.sequence, record);
+		}
+		std::ranges::sort(slots, {}, &std::pair<std::uint64_t, std::string_view>::first);
+		records_.reserve(slots.size());
+		for (auto& [sequence, record] : slots) {
+			records_.emplace_back(record);
+		}
+	}
+	bool FlightRecorderReader::IsValid() const
+	{
+		return valid_;
+	}
+	bool FlightRecorderReader::Next(Entry& e)
+	{
+		while (next_ < records_.size()) {
+			if (Decode_(records_[next_++], e)) {
+				return true;
+			}
+			discarded_++;
+		}
+		return false;
+	}
+	size_t FlightRecorderReader::GetDiscardedCount() const
+	{
+		return discarded_;
+	}
+	bool FlightRecorderReader::Decode_(std::string_view record, Entry& e)
+	{
+		bin::Cursor cursor{ record };
+		std::uint8_t level, flags;
+		std::int64_t timestamp, line;
+		std::string_view file, function;
+		if (!cursor.GetU8(level) || !cursor.GetU8(flags) ||
+			!cursor.GetSigned(timestamp) || !cursor.GetSigned(line)) {
+			return false;
+		}
+		e = Entry{};
+		e.level_ = Level(level);
+		e.timestamp_ = Clock::FromSystem(std::chrono::system_clock::time_point{
+			std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{ timestamp })
+		});
+		if (flags & bin::HasHResult) {
+			std::uint32_t hr;
+			if (!cursor.GetU32(hr)) {
+				return false;
+			}
+			e.hResult_ = hr;
+		}
+		if (!cursor.GetBytes(file) || !cursor.GetBytes(function)) {
+			return false;
+		}
+		pSite_ = std::make_unique<SiteRecord>(utl::FromUtf8(file), utl::FromUtf8(function), int(line));
+		e.pSite_ = &pSite_->site;
+		if (flags & bin::ShowSourceLine) {
+			e.showSourceLine_ = true;
+		}
+		else if (flags & bin::HideSourceLine) {
+			e.showSourceLine_ = false;
+		}
+		if (flags & bin::HasDeferredNote) {
+			std::string_view format;
+			std::array<DeferredNote::Arg, 8> args{};
+			size_t count = 0;
+			if (!cursor.GetBytes(format) || !bin::GetArgs(cursor, args, count)) {
+				return false;
+			}
+			format_ = utl::FromUtf8(format);
+			e.deferredNote_.emplace(std::wstring_view{ format_ }, std::span<const DeferredNote::Arg>{ args.data(), count });
+		}
+		else {
+			std::string_view note;
+			if (!cursor.GetBytes(note)) {
+				return false;
+			}
+			e.note_ = utl::FromUtf8(note);
+		}
+		return true;
+	}
+}
\ No newline at end of file
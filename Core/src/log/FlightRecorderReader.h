@@ -0,0 +1,43 @@
+#pragma once
+#include "Entry.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace chil::log
+{
+	// extracts the entries held in a FlightRecorderDriver ring file, oldest first; intended
+	// for after the fact, so the whole ring is read up front
+	class FlightRecorderReader
+	{
+	public:
+		FlightRecorderReader(std::filesystem::path path);
+		// false when the file is missing or is not a flight recorder ring
+		bool IsValid() const;
+		// decodes the next entry into e; false when the ring is exhausted
+		// the entry refers to strings owned by the reader and is valid until the next call
+		bool Next(Entry& e);
+		// slots that were written but failed validation (torn by a crash mid-write)
+		size_t GetDiscardedCount() const;
+	private:
+		// types
+		struct SiteRecord
+		{
+			SiteRecord(std::wstring fileName, std::wstring functionName, int line);
+			std::wstring file;
+			std::wstring function;
+			Site site;
+		};
+		// functions
+		bool Decode_(std::string_view record, Entry& e);
+		// data
+		bool valid_ = false;
+		std::vector<std::string> records_;
+		size_t next_ = 0;
+		size_t discarded_ = 0;
+		std::unique_ptr<SiteRecord> pSite_;
+		std::wstring format_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "JsonLinesDriver.h"
+#include "Entry.h"
+#include <Core/src/utl/String.h>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+
+namespace chil::log
+{
+	namespace
+	{
+		const char* GetLevelKey(Level level)
+		{
+			switch (level) {
+			case Level::Verbose: return "Verbose";
+			case Level::Debug: return "Debug";
+			case Level::Info: return "Info";
+			case Level::Warn: return "Warning";
+			case Level::Error: return "Error";
+			case Level::Fatal: return "Fatal";
+			default: return "Unknown";
+			}
+		}
+		template<typename T>
+		void AppendNumber(std::string& out, T value, int width = 0)
+		{
+			char digits[32];
+			const auto end = std::to_chars(digits, std::end(digits), value).ptr;
+			for (auto n = int(end - digits); n < width; n++) {
+				out += '0';
+			}
+			out.append(digits, end);
+		}
+		template<typename C>
+		bool NeedsEscape(C c)
+		{
+			return c == C('"') || c == C('\\') || unsigned(c) < 0x20;
+		}
+		void AppendEscape(std::string& out, unsigned int c)
+		{
+			constexpr char hex[] = "0123456789abcdef";
+			switch (c) {
+			case '"': out += "\\\""; break;
+			case '\\': out += "\\\\"; break;
+			case '\n': out += "\\n"; break;
+			case '\r': out += "\\r"; break;
+			case '\t': out += "\\t"; break;
+			default:
+				out += "\\u00";
+				out += hex[(c >> 4) & 0xF];
+				out += hex[c & 0xF];
+				break;
+			}
+		}
+		// runs of characters that need no escaping are transcoded in one call
+		void AppendString(std::string& out, std::wstring_view text)
+		{
+			out += '"';
+			size_t runStart = 0;
+			for (size_t i = 0; i < text.size(); i++) {
+				if (NeedsEscape(text[i])) {
+					utl::AppendUtf8(out, text.substr(runStart, i - runStart));
+					AppendEscape(out, unsigned(text[i]));
+					runStart = i + 1;
+				}
+			}
+			utl::AppendUtf8(out, text.substr(runStart));
+			out += '"';
+		}
+		// UTF-8 text is copied as-is apart from escapes (multi-byte sequences never contain
+		// bytes below 0x80)
+		void AppendString(std::string& out, std::u8string_view text)
+		{
+			out += '"';
+			size_t runStart = 0;
+			for (size_t i = 0; i < text.size(); i++) {
+				if (NeedsEscape(text[i])) {
+					out += utl::AsChars(text.substr(runStart, i - runStart));
+					AppendEscape(out, unsigned(text[i]));
+					runStart = i + 1;
+				}
+			}
+			out += utl::AsChars(text.substr(runStart));
+			out += '"';
+		}
+		// ISO 8601 in UTC with the clock's full sub-second precision
+		void AppendTimestamp(std::string& out, std::chrono::system_clock::time_point timestamp)
+		{
+			using namespace std::chrono;
+			using Time = hh_mm_ss<system_clock::duration>;
+			const auto day = floor<days>(timestamp);
+			const year_month_day date{ day };
+			const Time time{ timestamp - day };
+			out += '"';
+			AppendNumber(out, int(date.year()), 4);
+			out += '-';
+			AppendNumber(out, unsigned(date.month()), 2);
+			out += '-';
+			AppendNumber(out, unsigned(date.day()), 2);
+			out += 'T';
+			AppendNumber(out, time.hours().count(), 2);
+			out += ':';
+			AppendNumber(out, time.minutes().count(), 2);
+			out += ':';
+			AppendNumber(out, time.seconds().count(), 2);
+			if constexpr (Time::fractional_width > 0) {
+				out += '.';
+				AppendNumber(out, time.subseconds().count(), Time::fractional_width);
+			}
+			out += "Z\"";
+		}
+		void AppendValue(std::string& out, const DeferredNote::Arg& arg)
+		{
+			switch (arg.kind) {
+			case DeferredNote::Kind::Signed: AppendNumber(out, arg.value.i); break;
+			case DeferredNote::Kind::Unsigned: AppendNumber(out, arg.value.u); break;
+			case DeferredNote::Kind::Float:
+				// JSON has no representation for infinities or NaN
+				if (std::isfinite(arg.value.f)) {
+					AppendNumber(out, arg.value.f);
+				}
+				else {
+					out += "null";
+				}
+				break;
+			case DeferredNote::Kind::Bool: out += arg.value.b ? "true" : "false"; break;
+			case DeferredNote::Kind::Char: AppendString(out, { &arg.value.c, 1 }); break;
+			}
+		}
+	}
+
+	JsonLinesDriver::JsonLinesDriver(std::filesystem::path path)
+	{
+		// create any directories in the path that don't yet exist
+		std::filesystem::create_directories(path.parent_path());
+		// open file, append if already exists
+		file_.open(path, file_.out | file_.app | file_.binary);
+	}
+	JsonLinesDriver::~JsonLinesDriver()
+	{
+		Flush();
+	}
+	void JsonLinesDriver::Submit(const Entry& e)
+	{
+		thread_local std::string buffer;
+		buffer.clear();
+		FormatTo(buffer, e);
+		std::lock_guard lck{ mtx_ };
+		file_.write(buffer.data(), std::streamsize(buffer.size()));
+		bytesWritten_.fetch_add(buffer.size(), std::memory_order_relaxed);
+	}
+	void JsonLinesDriver::Flush()
+	{
+		std::lock_guard lck{ mtx_ };
+		file_.flush();
+	}
+	std::uint64_t JsonLinesDriver::GetBytesWritten() const
+	{
+		return bytesWritten_.load(std::memory_order_relaxed);
+	}
+	void JsonLinesDriver::FormatTo(std::string& out, const Entry& e)
+	{
+		out += "{\"time\":";
+		AppendTimestamp(out, Clock::ToSystem(e.timestamp_));
+		out += ",\"level\":\"";
+		out += GetLevelKey(e.level_);
+		out += "\",\"note\":";
+		if (e.deferredNote_) {
+			thread_local std::wstring note;
+			note.clear();
+			e.deferredNote_->ExpandTo(note);
+			AppendString(out, note);
+		}
+		else if (!e.noteUtf8_.empty()) {
+			AppendString(out, std::u8string_view{ e.noteUtf8_ });
+		}
+		else {
+			AppendString(out, e.note_);
+		}
+		if (e.pSite_) {
+			out += ",\"file\":";
+			AppendString(out, e.pSite_->GetFile() ? e.pSite_->GetFile() : L"");
+			out += ",\"function\":";
+			AppendString(out, e.pSite_->GetFunction() ? e.pSite_->GetFunction() : L"");
+			out += ",\"line\":";
+			AppendNumber(out, e.pSite_->GetLine());
+		}
+		if (e.hResult_) {
+			out += ",\"hresult\":";
+			AppendNumber(out, *e.hResult_);
+		}
+		if (e.fields_ && !e.fields_->IsEmpty()) {
+			out += ",\"fields\":{";
+			bool first = true;
+			for (const auto& field : e.fields_->Get()) {
+				if (!first) {
+					out += ',';
+				}
+				first = false;
+				AppendString(out, field.key);
+				out += ':';
+				if (field.isText) {
+					AppendString(out, e.fields_->GetText(field));
+				}
+				else {
+					AppendValue(out, field.value);
+				}
+			}
+			out += '}';
+		}
+		out += "}\n";
+	}
+}
\ No newline at end of file
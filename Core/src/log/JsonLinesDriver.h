@@ -0,0 +1,31 @@
+#pragma once
+#include "Driver.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace chil::log
+{
+	class IJsonLinesDriver : public IDriver {};
+
+	// writes one UTF-8 JSON object per line for log shipping pipelines, with structured
+	// fields as a nested object; each entry is serialized straight into a reused byte
+	// buffer, without building intermediate strings
+	class JsonLinesDriver : public IJsonLinesDriver
+	{
+	public:
+		JsonLinesDriver(std::filesystem::path path);
+		~JsonLinesDriver();
+		void Submit(const Entry&) override;
+		void Flush() override;
+		std::uint64_t GetBytesWritten() const override;
+		// appends the line for one entry, newline included
+		static void FormatTo(std::string& out, const Entry& e);
+	private:
+		std::mutex mtx_;
+		std::ofstream file_;
+		std::atomic<std::uint64_t> bytesWritten_ = 0;
+	};
+}
\ No newline at end of file
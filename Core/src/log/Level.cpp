@@ -1,4 +1,6 @@
 #include "Level.h"
+#include <algorithm>
+#include <cwctype>
 
 namespace chil::log
 {
@@ -15,4 +17,24 @@ namespace chil::log
 		default: return L"Unknown";
 		}
 	}
+	std::optional<Level> ParseLevelName(std::wstring_view name)
+	{
+		const auto matches = [name](std::wstring_view levelName) {
+			return std::ranges::equal(name, levelName, [](wchar_t a, wchar_t b) {
+				return std::towlower(a) == std::towlower(b);
+			});
+		};
+		if (matches(L"Warn")) {
+			return Level::Warn;
+		}
+		if (matches(L"None")) {
+			return Level::None;
+		}
+		for (auto level = Level::Fatal; level <= Level::Verbose; level = Level(int(level) + 1)) {
+			if (matches(GetLevelName(level))) {
+				return level;
+			}
+		}
+		return std::nullopt;
+	}
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace chil::log
 {
@@ -15,4 +17,7 @@ namespace chil::log
 	};
 
 	std::wstring GetLevelName(Level);
+	// level for a printed name or an enumerator name (so both Warning and Warn, and None),
+	// ignoring case
+	std::optional<Level> ParseLevelName(std::wstring_view name);
 }
\ No newline at end of file
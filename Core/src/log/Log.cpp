@@ -2,8 +2,16 @@
 #include <Core/src/ioc/Container.h> 
 #include <Core/src/ioc/Singletons.h>
 #include "SeverityLevelPolicy.h"
+#include "ModuleLevelPolicy.h"
+#include "RateLimitPolicy.h"
 #include "MsvcDebugDriver.h"
 #include "SimpleFileDriver.h"
+#include "BinaryFileDriver.h"
+#include "BufferedFileDriver.h"
+#include "CompressedFileDriver.h"
+#include "RotatingFileDriver.h"
+#include "FlightRecorderDriver.h"
+#include "JsonLinesDriver.h"
 #include "TextFormatter.h"
 
 namespace chil::log
@@ -20,10 +28,12 @@ namespace chil::log
 		ioc::Get().Register<log::IChannel>([] {
 			std::vector<std::shared_ptr<log::IDriver>> drivers{
 				ioc::Get().Resolve<log::IMsvcDebugDriver>(),
-				ioc::Get().Resolve<log::ISimpleFileDriver>()
+				ioc::Get().Resolve<log::IRotatingFileDriver>(),
+				ioc::Get().Resolve<log::IFlightRecorderDriver>()
 			};
 			auto pChan = std::make_shared<log::Channel>(std::move(drivers));
-			pChan->AttachPolicy(ioc::Get().Resolve<log::ISeverityLevelPolicy>());
+			pChan->AttachPolicy(ioc::Get().Resolve<log::IModuleLevelPolicy>());
+			pChan->AttachPolicy(ioc::Get().Resolve<log::IRateLimitPolicy>());
 			return pChan;
 		});
 		ioc::Get().Register<log::IMsvcDebugDriver>([] {
@@ -32,12 +42,38 @@ namespace chil::log
 		ioc::Get().Register<log::ISimpleFileDriver>([] {
 			return std::make_shared<log::SimpleFileDriver>("logs\\log.txt", ioc::Get().Resolve<log::ITextFormatter>());
 		});
+		ioc::Get().Register<log::IRotatingFileDriver>([] {
+			return std::make_shared<log::RotatingFileDriver>("logs\\log.txt", ioc::Get().Resolve<log::ITextFormatter>());
+		});
+		ioc::Get().Register<log::IFlightRecorderDriver>([] {
+			return std::make_shared<log::FlightRecorderDriver>("logs\\flight.bin");
+		});
+		ioc::Get().Register<log::IBufferedFileDriver>([] {
+			return std::make_shared<log::BufferedFileDriver>("logs\\log.txt", ioc::Get().Resolve<log::ITextFormatter>());
+		});
+		ioc::Get().Register<log::ICompressedFileDriver>([] {
+			return std::make_shared<log::CompressedFileDriver>("logs\\log.lz", ioc::Get().Resolve<log::ITextFormatter>());
+		});
+		ioc::Get().Register<log::IBinaryFileDriver>([] {
+			return std::make_shared<log::BinaryFileDriver>("logs\\log.bin");
+		});
+		ioc::Get().Register<log::IJsonLinesDriver>([] {
+			return std::make_shared<log::JsonLinesDriver>("logs\\log.jsonl");
+		});
 		ioc::Get().Register<log::ITextFormatter>([] {
 			return std::make_shared<log::TextFormatter>();
 		});
 		ioc::Get().Register<log::ISeverityLevelPolicy>([] {
 			return std::make_shared<log::SeverityLevelPolicy>(log::Level::Error);
 		});
+		ioc::Get().Register<log::IModuleLevelPolicy>([] {
+			return std::make_shared<log::ModuleLevelPolicy>(log::ModuleLevelPolicy::Config{ .defaultLevel = log::Level::Error });
+		});
+		ioc::Get().Register<log::IRateLimitPolicy>([] {
+			// only fatals always get through; an error hit every frame is what the limit is for,
+			// and what it drops is still counted in the summary entries flushed after it
+			return std::make_shared<log::RateLimitPolicy>(log::RateLimitPolicy::Limit{ .exemptLevel = log::Level::Fatal });
+		});
 
 		// Singleton
 		ioc::Sing().RegisterPassthru<log::IChannel>();
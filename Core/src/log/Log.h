@@ -2,6 +2,17 @@
 #include "Channel.h" 
 #include "EntryBuilder.h" 
 
+// least severe level compiled into the binary, named by its Level enumerator
+// (e.g. /DZC_LOG_MIN_LEVEL=Warn); the level-specific chilog_* macros below this
+// level compile to nothing and never evaluate their arguments
+#ifndef ZC_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define ZC_LOG_MIN_LEVEL Info
+#else
+#define ZC_LOG_MIN_LEVEL Verbose
+#endif
+#endif
+
 namespace chil::log
 {
 	IChannel* GetDefaultChannel();
@@ -13,6 +24,24 @@ namespace chil::log
 #else 
 	inline constexpr int defaultTraceSkip = 6;
 #endif 
+
+	inline constexpr Level minCompiledLevel = Level::ZC_LOG_MIN_LEVEL;
 }
 
-#define chilog log::EntryBuilder{ __FILEW__, __FUNCTIONW__, __LINE__ }.chan(log::GetDefaultChannel()).trace_skip(log::defaultTraceSkip)
\ No newline at end of file
+#define chilog log::EntryBuilder{ ZZ_LOG_SITE_(log::Level::Error) }.chan(log::GetDefaultChannel()).trace_skip(log::defaultTraceSkip)
+
+// level-specific entry points: stripped at compile time below ZC_LOG_MIN_LEVEL, and
+// checked against the site's enable switch and the default channel's policies before the
+// entry or its note is built; further builder calls can be chained after the macro,
+// e.g. chilog_warn(L"...").hr();
+#define ZZ_CHILOG_LEVEL_(lvl, fn, ...) \
+	if constexpr (log::Level::lvl > log::minCompiledLevel) {} \
+	else if (const log::Site& zz_site = ZZ_LOG_SITE_(log::Level::lvl); \
+		!zz_site.IsEnabled() || !log::GetDefaultChannel()->AcceptsLevel(log::Level::lvl)) {} \
+	else log::EntryBuilder{ zz_site }.chan(log::GetDefaultChannel()).trace_skip(log::defaultTraceSkip).fn(__VA_ARGS__)
+#define chilog_fatal(...) ZZ_CHILOG_LEVEL_(Fatal, fatal, __VA_ARGS__)
+#define chilog_error(...) ZZ_CHILOG_LEVEL_(Error, error, __VA_ARGS__)
+#define chilog_warn(...) ZZ_CHILOG_LEVEL_(Warn, warn, __VA_ARGS__)
+#define chilog_info(...) ZZ_CHILOG_LEVEL_(Info, info, __VA_ARGS__)
+#define chilog_debug(...) ZZ_CHILOG_LEVEL_(Debug, debug, __VA_ARGS__)
+#define chilog_verbose(...) ZZ_CHILOG_LEVEL_(Verbose, verbose, __VA_ARGS__)
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "Metrics.h"
+#include "Channel.h"
+#include <Core/src/utl/String.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iterator>
+
+namespace chil::log
+{
+	namespace
+	{
+		void AppendHistogramJson(std::string& out, const LatencyHistogram::Snapshot& histogram)
+		{
+			std::format_to(std::back_inserter(out), R"({{"count":{},"meanNs":{:.1f},"p50Ns":{:.0f},"p99Ns":{:.0f},"p999Ns":{:.0f}}})",
+				histogram.count, histogram.GetMeanNanos(), histogram.GetPercentileNanos(.5),
+				histogram.GetPercentileNanos(.99), histogram.GetPercentileNanos(.999));
+		}
+	}
+
+	double LatencyHistogram::Snapshot::GetMeanNanos() const
+	{
+		return count ? double(totalNanos) / double(count) : 0.;
+	}
+	double LatencyHistogram::Snapshot::GetPercentileNanos(double q) const
+	{
+		if (!count) {
+			return 0.;
+		}
+		const auto rank = std::max<std::uint64_t>(1, std::uint64_t(std::ceil(q * double(count))));
+		std::uint64_t seen = 0;
+		for (size_t i = 0; i < bucketCount; i++) {
+			seen += buckets[i];
+			if (seen >= rank) {
+				return double(std::uint64_t(1) << i);
+			}
+		}
+		return double(std::uint64_t(1) << (bucketCount - 1));
+	}
+	void LatencyHistogram::Record(Clock::duration duration)
+	{
+		const auto nanos = std::max<std::int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+		const auto bucket = std::min<size_t>(std::bit_width(std::uint64_t(nanos)), bucketCount - 1);
+		counts_.Add(bucket);
+		counts_.Add(bucketCount, std::uint64_t(nanos));
+	}
+	LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const
+	{
+		const auto counts = counts_.GetAll();
+		Snapshot snapshot;
+		std::copy_n(counts.begin(), bucketCount, snapshot.buckets.begin());
+		for (auto n : snapshot.buckets) {
+			snapshot.count += n;
+		}
+		snapshot.totalNanos = counts[bucketCount];
+		return snapshot;
+	}
+
+	std::string FormatStatsJson(const ChannelStats& stats)
+	{
+		std::string out = std::format(R"({{"time":"{:%FT%TZ}","submitted":{{)",
+			std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+		// Level::None is not a level entries are logged at
+		for (size_t i = 1; i < levelCount; i++) {
+			std::format_to(std::back_inserter(out), R"({}"{}":{})", i > 1 ? "," : "",
+				utl::ToUtf8(GetLevelName(Level(i))), stats.submitted[i]);
+		}
+		out += R"(},"filtered":[)";
+		for (size_t i = 0; i < stats.filtered.size(); i++) {
+			std::format_to(std::back_inserter(out), "{}{}", i ? "," : "", stats.filtered[i]);
+		}
+		out += R"(],"drivers":[)";
+		for (size_t i = 0; i < stats.drivers.size(); i++) {
+			const auto& driver = stats.drivers[i];
+			std::format_to(std::back_inserter(out), R"({}{{"name":"{}","bytes":{},"submit":)",
+				i ? "," : "", driver.name, driver.bytesWritten);
+			AppendHistogramJson(out, driver.submit);
+			out += R"(,"flush":)";
+			AppendHistogramJson(out, driver.flush);
+			out += '}';
+		}
+		out += "]}";
+		return out;
+	}
+
+	StatsDumper::StatsDumper(std::shared_ptr<IChannel> pChannel, std::filesystem::path path, std::chrono::milliseconds interval)
+		:
+		pChannel_{ std::move(pChannel) },
+		path_{ std::move(path) },
+		interval_{ interval }
+	{
+		std::filesystem::create_directories(path_.parent_path());
+		dumpThread_ = std::jthread{ [this](std::stop_token stop) { DumpKernel_(std::move(stop)); } };
+	}
+	StatsDumper::~StatsDumper()
+	{
+		dumpThread_.request_stop();
+		dumpThread_.join();
+		Dump();
+	}
+	void StatsDumper::Dump()
+	{
+		const auto line = FormatStatsJson(pChannel_->GetStats());
+		std::lock_guard lck{ mtx_ };
+		// opened per line so that the file can be moved or truncated by whatever reads it
+		std::ofstream file{ path_, std::ios::out | std::ios::app | std::ios::binary };
+		file << line << '\n';
+	}
+	void StatsDumper::DumpKernel_(std::stop_token stop) noexcept
+	{
+		std::unique_lock lck{ mtx_ };
+		while (!cv_.wait_for(lck, stop, interval_, [&stop] { return stop.stop_requested(); })) {
+			lck.unlock();
+			try {
+				Dump();
+			}
+			catch (...) {
+				// a failed dump is skipped; the next one may succeed
+			}
+			lck.lock();
+		}
+	}
+}
\ No newline at end of file
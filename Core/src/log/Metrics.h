@@ -0,0 +1,101 @@
+#pragma once
+#include "Clock.h"
+#include "Level.h"
+#include <Core/src/ccr/ShardedCounters.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace chil::log
+{
+	class IChannel;
+	class IDriver;
+
+	inline constexpr size_t levelCount = size_t(Level::Verbose) + 1;
+
+	// histogram of durations in power-of-two nanosecond buckets: bucket 0 counts durations
+	// under 1ns and bucket i those in [2^(i-1), 2^i) ns, the last one catching everything
+	// longer. recording is two sharded adds, so any number of threads can time into one
+	class LatencyHistogram
+	{
+	public:
+		// types
+		static constexpr size_t bucketCount = 40;
+		struct Snapshot
+		{
+			std::array<std::uint64_t, bucketCount> buckets{};
+			std::uint64_t count = 0;
+			std::uint64_t totalNanos = 0;
+			double GetMeanNanos() const;
+			// upper edge of the bucket holding the q-quantile, so within a factor of two
+			double GetPercentileNanos(double q) const;
+		};
+		// functions
+		void Record(Clock::duration duration);
+		Snapshot GetSnapshot() const;
+	private:
+		// the buckets, then the running total in nanoseconds
+		ccr::ShardedCounters<bucketCount + 1> counts_;
+	};
+
+	// timings a channel keeps for each of its drivers
+	struct DriverMetrics
+	{
+		LatencyHistogram submit;
+		LatencyHistogram flush;
+	};
+
+	struct DriverStats
+	{
+		// type name of the driver, for telling drivers apart in dumps
+		std::string name;
+		std::uint64_t bytesWritten = 0;
+		LatencyHistogram::Snapshot submit;
+		LatencyHistogram::Snapshot flush;
+	};
+
+	// snapshot of a channel's counters since it was created
+	struct ChannelStats
+	{
+		// entries submitted to the channel, by level
+		std::array<std::uint64_t, levelCount> submitted{};
+		// entries rejected by each policy, in the order they were attached
+		std::vector<std::uint64_t> filtered;
+		// in the order the drivers were attached
+		std::vector<DriverStats> drivers;
+	};
+
+	// one JSON object (no trailing newline) with the counters, the byte counts and the
+	// latency count, mean and p50/p99/p999 of each driver
+	std::string FormatStatsJson(const ChannelStats& stats);
+
+	// appends the stats of a channel to a file as JSON lines on a background thread, for
+	// scraping by whatever watches the file; a last line is written on destruction
+	class StatsDumper
+	{
+	public:
+		StatsDumper(std::shared_ptr<IChannel> pChannel, std::filesystem::path path, std::chrono::milliseconds interval = std::chrono::seconds{ 10 });
+		~StatsDumper();
+		StatsDumper(const StatsDumper&) = delete;
+		StatsDumper& operator=(const StatsDumper&) = delete;
+		// writes a line now
+		void Dump();
+	private:
+		// functions
+		void DumpKernel_(std::stop_token stop) noexcept;
+		// data
+		std::shared_ptr<IChannel> pChannel_;
+		std::filesystem::path path_;
+		std::chrono::milliseconds interval_;
+		std::mutex mtx_;
+		std::condition_variable_any cv_;
+		std::jthread dumpThread_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "ModuleLevelPolicy.h"
+#include "Entry.h"
+#include <Core/src/utl/String.h>
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
+namespace chil::log
+{
+	namespace
+	{
+		constexpr std::uint32_t versionMask = 0xFF'FFFF;
+
+		// paths are compared lower-cased (ASCII only) with backslash separators
+		std::wstring NormalizePath(std::wstring_view path)
+		{
+			std::wstring normalized;
+			normalized.reserve(path.size());
+			for (auto c : path) {
+				if (c == L'/') {
+					c = L'\\';
+				}
+				else if (c >= L'A' && c <= L'Z') {
+					c += L'a' - L'A';
+				}
+				normalized += c;
+			}
+			return normalized;
+		}
+		std::wstring_view Trim(std::wstring_view text)
+		{
+			constexpr std::wstring_view space = L" \t\r";
+			const auto first = text.find_first_not_of(space);
+			if (first == std::wstring_view::npos) {
+				return {};
+			}
+			return text.substr(first, text.find_last_not_of(space) - first + 1);
+		}
+		// fragment occurs in the path bounded by separators (or the ends of the path)
+		bool ContainsComponents(std::wstring_view path, std::wstring_view fragment)
+		{
+			for (auto pos = path.find(fragment); pos != std::wstring_view::npos; pos = path.find(fragment, pos + 1)) {
+				const auto end = pos + fragment.size();
+				if ((pos == 0 || path[pos - 1] == L'\\') && (end == path.size() || path[end] == L'\\')) {
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+
+	ModuleLevelPolicy::ModuleLevelPolicy(Config config, size_t capacity)
+		:
+		slots_{ capacity }
+	{
+		SetConfig(std::move(config));
+	}
+	ModuleLevelPolicy::ModuleLevelPolicy(std::filesystem::path configPath, Config fallback, Watch watch)
+		:
+		ModuleLevelPolicy{ std::move(fallback), watch.capacity }
+	{
+		configPath_ = std::move(configPath);
+		interval_ = watch.interval;
+		Reload();
+		watchThread_ = std::jthread{ [this](std::stop_token stop) { WatchKernel_(std::move(stop)); } };
+	}
+	ModuleLevelPolicy::~ModuleLevelPolicy()
+	{}
+	bool ModuleLevelPolicy::TransformFilter(Entry& e)
+	{
+		return e.level_ <= GetLevel(e.pSite_);
+	}
+	Level ModuleLevelPolicy::GetMaxLevel() const
+	{
+		return pRules_.load(std::memory_order_acquire)->maxLevel;
+	}
+	Level ModuleLevelPolicy::GetLevel(const Site* pSite)
+	{
+		const auto& rules = *pRules_.load(std::memory_order_acquire);
+		if (!pSite) {
+			return rules.defaultLevel;
+		}
+		const auto pSlot = slots_.Find(pSite);
+		if (!pSlot) {
+			return Resolve_(rules, pSite);
+		}
+		// a racing thread may store a resolution against older rules over a newer one; the
+		// next lookup then sees the stale version and resolves again
+		if (const auto resolved = pSlot->resolved.load(std::memory_order_relaxed); (resolved >> 8) == rules.version) {
+			return Level(resolved & 0xFF);
+		}
+		const auto level = Resolve_(rules, pSite);
+		pSlot->resolved.store(rules.version << 8 | std::uint32_t(level), std::memory_order_relaxed);
+		return level;
+	}
+	void ModuleLevelPolicy::SetConfig(Config config)
+	{
+		auto pNext = std::make_unique<Rules>(Rules{
+			.defaultLevel = config.defaultLevel,
+			.maxLevel = config.defaultLevel,
+		});
+		for (auto& rule : config.rules) {
+			auto fragment = NormalizePath(Trim(rule.fragment));
+			const auto first = fragment.find_first_not_of(L'\\');
+			if (first == std::wstring::npos) {
+				continue;
+			}
+			fragment = fragment.substr(first, fragment.find_last_not_of(L'\\') - first + 1);
+			pNext->maxLevel = std::max(pNext->maxLevel, rule.level);
+			// a fragment given twice takes its last level
+			if (auto i = std::ranges::find(pNext->rules, fragment, &Rule::fragment); i != pNext->rules.end()) {
+				i->level = rule.level;
+			}
+			else {
+				pNext->rules.push_back({ std::move(fragment), rule.level });
+			}
+		}
+		std::ranges::stable_sort(pNext->rules, std::ranges::greater{}, [](const Rule& r) { return r.fragment.size(); });
+		std::lock_guard lck{ updateMtx_ };
+		// version 0 never matches, so that a zeroed slot reads as unresolved
+		const auto pCurrent = pRules_.load(std::memory_order_relaxed);
+		pNext->version = pCurrent ? (pCurrent->version + 1) & versionMask : 1;
+		if (pNext->version == 0) {
+			pNext->version = 1;
+		}
+		pRules_.store(pNext.get(), std::memory_order_release);
+		rulesPtrs_.push_back(std::move(pNext));
+	}
+	bool ModuleLevelPolicy::Reload()
+	{
+		std::string text;
+		{
+			std::lock_guard lck{ updateMtx_ };
+			std::error_code ec;
+			const auto time = std::filesystem::last_write_time(configPath_, ec);
+			if (ec) {
+				return false;
+			}
+			const auto size = std::filesystem::file_size(configPath_, ec);
+			if (ec || (time == configTime_ && size == configSize_)) {
+				return false;
+			}
+			// the stamp is taken before parsing, so that a bad file is reported once rather
+			// than on every check until it is fixed
+			configTime_ = time;
+			configSize_ = size;
+			std::ifstream file{ configPath_, std::ios::binary };
+			if (!file) {
+				return false;
+			}
+			text.assign(std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{});
+		}
+		SetConfig(ParseConfig(utl::FromUtf8(text)));
+		return true;
+	}
+	std::uint32_t ModuleLevelPolicy::GetVersion() const
+	{
+		return pRules_.load(std::memory_order_acquire)->version;
+	}
+	std::string ModuleLevelPolicy::GetReloadError() const
+	{
+		std::lock_guard lck{ updateMtx_ };
+		return reloadError_;
+	}
+	ModuleLevelPolicy::Config ModuleLevelPolicy::ParseConfig(std::wstring_view text)
+	{
+		if (text.starts_with(L'\xFEFF')) {
+			text.remove_prefix(1);
+		}
+		Config config;
+		for (size_t lineNumber = 1; !text.empty(); lineNumber++) {
+			const auto eol = text.find(L'\n');
+			const auto line = Trim(text.substr(0, eol));
+			text.remove_prefix(eol == std::wstring_view::npos ? text.size() : eol + 1);
+			if (line.empty() || line.starts_with(L'#')) {
+				continue;
+			}
+			const auto equals = line.rfind(L'=');
+			if (equals == std::wstring_view::npos) {
+				throw LevelConfigException{ std::format(L"line {}: expected <path> = <level>", lineNumber) };
+			}
+			const auto fragment = Trim(line.substr(0, equals));
+			const auto levelName = Trim(line.substr(equals + 1));
+			const auto level = ParseLevelName(levelName);
+			if (!level) {
+				throw LevelConfigException{ std::format(L"line {}: unknown level '{}'", lineNumber, levelName) };
+			}
+			if (fragment == L"*") {
+				config.defaultLevel = *level;
+			}
+			else if (fragment.find_first_not_of(L"/\\") == std::wstring_view::npos) {
+				throw LevelConfigException{ std::format(L"line {}: missing path", lineNumber) };
+			}
+			else {
+				config.rules.push_back({ std::wstring{ fragment }, *level });
+			}
+		}
+		return config;
+	}
+	Level ModuleLevelPolicy::Resolve_(const Rules& rules, const Site* pSite)
+	{
+		if (pSite->GetFile() && !rules.rules.empty()) {
+			const auto path = NormalizePath(pSite->GetFile());
+			for (auto& rule : rules.rules) {
+				if (ContainsComponents(path, rule.fragment)) {
+					return rule.level;
+				}
+			}
+		}
+		return rules.defaultLevel;
+	}
+	void ModuleLevelPolicy::WatchKernel_(std::stop_token stop) noexcept
+	{
+		std::unique_lock lck{ watchMtx_ };
+		while (!watchCv_.wait_for(lck, stop, interval_, [&stop] { return stop.stop_requested(); })) {
+			std::string error;
+			try {
+				if (!Reload()) {
+					continue;
+				}
+			}
+			catch (const std::exception& e) {
+				error = e.what();
+			}
+			catch (...) {
+				error = "unknown error";
+			}
+			std::lock_guard updateLck{ updateMtx_ };
+			reloadError_ = std::move(error);
+		}
+	}
+}
\ No newline at end of file
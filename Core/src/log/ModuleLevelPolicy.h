@@ -0,0 +1,122 @@
+#pragma once
+#include "Policy.h"
+#include "Level.h"
+#include "Exception.h"
+#include "SiteTable.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace chil::log
+{
+	class Site;
+
+	ZC_EX_DEF(LevelConfigException);
+
+	class IModuleLevelPolicy : public IPolicy {};
+
+	// severity threshold chosen per module: each rule names a source path fragment (e.g.
+	// Core/src/ccr or WindowApp) and the entries from sites under it are held to the rule's
+	// level, with the longest matching fragment winning and the default level applying
+	// elsewhere. fragments match whole path components anywhere in the site's file path,
+	// case-insensitively and with either kind of slash, since sites carry absolute paths
+	//
+	// a site's level is resolved against the rules the first time it is seen and cached in
+	// a SiteTable, tagged with the version of the rules it was resolved against; after that
+	// the filter is a hash probe and a compare. sites that do not find a slot are resolved
+	// on every entry
+	//
+	// optionally the rules come from a UTF-8 config file that a watcher thread re-reads
+	// whenever its write time or size changes, so a running process can be switched to
+	// Verbose for one subsystem. one rule per line, "<fragment> = <level>", with "*" naming
+	// the default, blank lines and lines starting with # ignored:
+	//     * = Warn
+	//     Core/src/ccr = Verbose
+	// a file that fails to parse leaves the previous rules in place, and a missing file
+	// leaves the rules given to the constructor
+	class ModuleLevelPolicy : public IModuleLevelPolicy
+	{
+	public:
+		// types
+		struct Rule
+		{
+			std::wstring fragment;
+			Level level;
+		};
+		struct Config
+		{
+			Level defaultLevel = Level::Error;
+			std::vector<Rule> rules;
+		};
+		struct Watch
+		{
+			// time between checks of the config file
+			std::chrono::milliseconds interval{ 500 };
+			// distinct sites cached (rounded up to a power of two)
+			size_t capacity = 4096;
+		};
+		// functions
+		ModuleLevelPolicy(Config config = {}, size_t capacity = 4096);
+		// loads the config file if it exists (throwing LevelConfigException if it does not
+		// parse) and starts watching it
+		ModuleLevelPolicy(std::filesystem::path configPath, Config fallback = {}, Watch watch = {});
+		~ModuleLevelPolicy();
+		bool TransformFilter(Entry&) override;
+		// most verbose level of the default and all rules
+		Level GetMaxLevel() const override;
+		// threshold for entries from the given site (or the default for no site)
+		Level GetLevel(const Site*);
+		void SetConfig(Config config);
+		// re-reads the config file now if it has changed since it was last read; returns
+		// whether new rules were applied, and throws LevelConfigException on a parse error
+		bool Reload();
+		// incremented whenever new rules are applied
+		std::uint32_t GetVersion() const;
+		// message of the last failed reload by the watcher, empty if the last one succeeded
+		std::string GetReloadError() const;
+		static Config ParseConfig(std::wstring_view text);
+	private:
+		// types
+		struct Rules
+		{
+			std::uint32_t version;
+			Level defaultLevel;
+			Level maxLevel;
+			// normalized fragments, longest first
+			std::vector<Rule> rules;
+		};
+		struct Slot
+		{
+			std::atomic<const Site*> pSite = nullptr;
+			// version << 8 | level of the last resolution, 0 when not yet resolved
+			std::atomic<std::uint32_t> resolved = 0;
+		};
+		// functions
+		static Level Resolve_(const Rules& rules, const Site* pSite);
+		void WatchKernel_(std::stop_token stop) noexcept;
+		// data
+		SiteTable<Slot> slots_;
+		std::atomic<const Rules*> pRules_ = nullptr;
+		// serializes writers; superseded rule sets are retired rather than freed, as in
+		// Channel, since a filtering thread may still be reading one
+		mutable std::mutex updateMtx_;
+		std::vector<std::unique_ptr<const Rules>> rulesPtrs_;
+		// config file state, guarded by updateMtx_
+		std::filesystem::path configPath_;
+		std::filesystem::file_time_type configTime_{};
+		std::uintmax_t configSize_ = 0;
+		std::string reloadError_;
+		std::chrono::milliseconds interval_{ 0 };
+		std::mutex watchMtx_;
+		std::condition_variable_any watchCv_;
+		std::jthread watchThread_;
+	};
+}
\ No newline at end of file
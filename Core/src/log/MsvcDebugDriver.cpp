@@ -13,7 +13,10 @@ namespace chil::log
 	void MsvcDebugDriver::Submit(const Entry& e)
 	{
 		if (pFormatter_) {
-			OutputDebugStringW(pFormatter_->Format(e).c_str());
+			thread_local std::wstring buffer;
+			buffer.clear();
+			pFormatter_->FormatTo(buffer, e);
+			OutputDebugStringW(buffer.c_str());
 		}
 		// TODO: how to log stuff from log system
 	}
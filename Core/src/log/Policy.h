@@ -1,4 +1,6 @@
 #pragma once
+#include "Level.h"
+#include <vector>
 
 namespace chil::log
 {
@@ -9,5 +11,12 @@ namespace chil::log
 	public:
 		virtual ~IPolicy() = default;
 		virtual bool TransformFilter(Entry&) = 0;
+		// least severe level this policy can let through; used to reject entries before
+		// they are built, so it must never be stricter than TransformFilter
+		virtual Level GetMaxLevel() const { return Level::Verbose; }
+		// entries the policy has held back to emit later (reports of what it dropped, say);
+		// the channel collects them on Flush and passes them through the policies after this
+		// one to the drivers
+		virtual void TakePending(std::vector<Entry>&) {}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "RateLimitPolicy.h"
+#include "Entry.h"
+#include <Core/src/utl/String.h>
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace chil::log
+{
+	RateLimitPolicy::RateLimitPolicy(Limit limit)
+		:
+		interval_{ std::max<std::int64_t>(1, std::int64_t(
+			Clock::period::den / (limit.rate * Clock::period::num))) },
+		tolerance_{ interval_ * std::max(1u, limit.burst) },
+		exemptLevel_{ limit.exemptLevel },
+		slots_{ limit.capacity }
+	{}
+	bool RateLimitPolicy::TransformFilter(Entry& e)
+	{
+		if (!e.pSite_ || e.level_ <= exemptLevel_) {
+			return true;
+		}
+		auto pSlot = slots_.Find(e.pSite_);
+		if (!pSlot) {
+			return true;
+		}
+		// admit when the arrival time pushed forward by one interval stays within the burst
+		// tolerance of now
+		const auto now = std::int64_t(e.timestamp_.time_since_epoch().count());
+		auto arrival = pSlot->arrival.load(std::memory_order_relaxed);
+		for (;;) {
+			const auto next = std::max(arrival, now) + interval_;
+			if (next - now > tolerance_) {
+				pSlot->suppressedLevel.store(e.level_, std::memory_order_relaxed);
+				pSlot->suppressed.fetch_add(1, std::memory_order_relaxed);
+				suppressedCount_.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			if (pSlot->arrival.compare_exchange_weak(arrival, next, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		if (const auto suppressed = pSlot->suppressed.exchange(0, std::memory_order_relaxed)) {
+			// the annotation has to go into the text, so a deferred note is expanded here
+			if (e.deferredNote_) {
+				e.note_.clear();
+				e.deferredNote_->ExpandTo(e.note_);
+				e.deferredNote_.reset();
+				e.noteUtf8_.clear();
+			}
+			if (!e.noteUtf8_.empty()) {
+				char annotation[64];
+				const auto end = std::format_to_n(annotation, sizeof(annotation),
+					" [suppressed {} similar messages]", suppressed).out;
+				e.noteUtf8_ += utl::AsUtf8({ annotation, size_t(end - annotation) });
+			}
+			else {
+				std::format_to(std::back_inserter(e.note_), L" [suppressed {} similar messages]", suppressed);
+			}
+		}
+		return true;
+	}
+	void RateLimitPolicy::TakePending(std::vector<Entry>& pending)
+	{
+		// the exchange decides who reports a count: this, or the site's next admitted entry
+		slots_.ForEach([&pending](Slot& slot, const Site* pSite) {
+			if (const auto suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed)) {
+				pending.push_back(Entry{
+					.level_ = slot.suppressedLevel.load(std::memory_order_relaxed),
+					.note_ = std::format(L"[suppressed {} similar messages]", suppressed),
+					.pSite_ = pSite,
+					.timestamp_ = Clock::now(),
+					.captureTrace_ = false,
+				});
+			}
+		});
+	}
+	size_t RateLimitPolicy::GetSuppressedCount() const
+	{
+		return suppressedCount_.load(std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
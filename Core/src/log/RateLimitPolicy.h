@@ -0,0 +1,60 @@
+#pragma once
+#include "Policy.h"
+#include "SiteTable.h"
+#include <atomic>
+#include <cstdint>
+
+namespace chil::log
+{
+	class Site;
+
+	class IRateLimitPolicy : public IPolicy {};
+
+	// limits how fast each call site may emit, so that an error path hit every frame does
+	// not swamp the drivers; each site gets a token bucket (kept as a GCRA arrival time)
+	// and entries over the limit are dropped and counted, with the count reported on the
+	// next entry the site is allowed to emit, or as an entry of its own when the channel is
+	// flushed first (so a flood followed by silence is still reported)
+	// sites are found in a SiteTable, so the lookup takes no lock
+	class RateLimitPolicy : public IRateLimitPolicy
+	{
+	public:
+		// types
+		struct Limit
+		{
+			// sustained entries per second allowed from one site
+			double rate = 10.;
+			// entries a quiet site may emit back to back before the rate applies
+			unsigned int burst = 20;
+			// distinct sites tracked (rounded up to a power of two); sites that do not find a
+			// slot are not limited
+			size_t capacity = 1024;
+			// entries this severe or more are never limited (None limits every level)
+			Level exemptLevel = Level::None;
+		};
+		// functions
+		RateLimitPolicy(Limit limit = {});
+		bool TransformFilter(Entry&) override;
+		// one entry per site with drops not yet reported, at the level last dropped there
+		void TakePending(std::vector<Entry>&) override;
+		// entries dropped so far over all sites
+		size_t GetSuppressedCount() const;
+	private:
+		// types
+		struct Slot
+		{
+			std::atomic<const Site*> pSite = nullptr;
+			// theoretical arrival time of the next entry, in clock ticks
+			std::atomic<std::int64_t> arrival = 0;
+			// entries dropped since the site last got through, and the level of the last one
+			std::atomic<std::uint32_t> suppressed = 0;
+			std::atomic<Level> suppressedLevel = Level::None;
+		};
+		// data
+		std::int64_t interval_;
+		std::int64_t tolerance_;
+		Level exemptLevel_;
+		SiteTable<Slot> slots_;
+		std::atomic<size_t> suppressedCount_ = 0;
+	};
+}
\ No newline at end of file
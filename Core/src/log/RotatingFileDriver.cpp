@@ -0,0 +1,219 @@
+#include "RotatingFileDriver.h"
+#include "Entry.h"
+#include "Exception.h"
+#include "TextFormatter.h"
+#include <Core/src/win/ChilWin.h>
+#include <algorithm>
+#include <format>
+
+namespace chil::log
+{
+	RotatingFileDriver::RotatingFileDriver(std::filesystem::path path, std::shared_ptr<ITextFormatter> pFormatter, Rotation rotation)
+		:
+		path_{ std::move(path) },
+		rotation_{ rotation },
+		pFormatter_{ std::move(pFormatter) }
+	{
+		// create any directories in the path that don't yet exist
+		std::filesystem::create_directories(path_.parent_path());
+		// the first segment is opened here so that a bad path fails loudly at construction
+		if (!OpenSegment_()) {
+			throw DriverException{ L"Failed to open log file " + path_.wstring() };
+		}
+		buffer_.reserve(rotation_.commitBytes * 2);
+		writing_.reserve(rotation_.commitBytes * 2);
+		writerThread_ = std::thread{ &RotatingFileDriver::WriterKernel_, this };
+	}
+	RotatingFileDriver::~RotatingFileDriver()
+	{
+		{
+			std::lock_guard lck{ mtx_ };
+			stopping_ = true;
+		}
+		wakeCv_.notify_one();
+		writerThread_.join();
+		if (hFile_) {
+			CloseHandle(hFile_);
+		}
+	}
+	void RotatingFileDriver::Submit(const Entry& e)
+	{
+		if (!pFormatter_) {
+			return;
+		}
+		thread_local std::string text;
+		text.clear();
+		pFormatter_->FormatUtf8To(text, e);
+
+		bool wake = false;
+		{
+			std::lock_guard lck{ mtx_ };
+			if (buffer_.size() >= rotation_.maxBacklogBytes) {
+				stats_.dropped++;
+				return;
+			}
+			if (buffer_.empty()) {
+				oldestPending_ = std::chrono::steady_clock::now();
+			}
+			buffer_ += text;
+			stats_.entries++;
+			wake = buffer_.size() >= rotation_.commitBytes;
+		}
+		if (wake) {
+			wakeCv_.notify_one();
+		}
+	}
+	void RotatingFileDriver::SetFormatter(std::shared_ptr<ITextFormatter> pFormatter)
+	{
+		pFormatter_ = std::move(pFormatter);
+	}
+	void RotatingFileDriver::Flush()
+	{
+		std::unique_lock lck{ mtx_ };
+		const auto ticket = ++flushRequested_;
+		wakeCv_.notify_one();
+		flushedCv_.wait(lck, [&] { return flushCompleted_ >= ticket || stopping_; });
+	}
+	RotatingFileDriver::Stats RotatingFileDriver::GetStats() const
+	{
+		std::lock_guard lck{ mtx_ };
+		return stats_;
+	}
+	std::uint64_t RotatingFileDriver::GetBytesWritten() const
+	{
+		return GetStats().bytes;
+	}
+	std::filesystem::path RotatingFileDriver::GetArchivePath(size_t index) const
+	{
+		// logs/log.txt => logs/log.3.txt
+		auto archive = path_;
+		archive.replace_filename(std::format(L"{}.{}{}",
+			path_.stem().wstring(), index, path_.extension().wstring()));
+		return archive;
+	}
+	bool RotatingFileDriver::OpenSegment_()
+	{
+		const auto hFile = CreateFileW(path_.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE,
+			nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (hFile == INVALID_HANDLE_VALUE) {
+			hFile_ = nullptr;
+			return false;
+		}
+		hFile_ = hFile;
+		// continue an existing active file from its end
+		LARGE_INTEGER size{};
+		GetFileSizeEx(hFile, &size);
+		LARGE_INTEGER zero{};
+		SetFilePointerEx(hFile, zero, nullptr, FILE_END);
+		segmentSize_ = size_t(size.QuadPart);
+		segmentStart_ = std::chrono::system_clock::now();
+		// reserve the whole segment up front (without moving end of file) so that appends
+		// only advance the end of file instead of allocating clusters as they go; the
+		// unused tail is released when the handle is closed
+		if (segmentSize_ < rotation_.segmentBytes) {
+			FILE_ALLOCATION_INFO allocation{};
+			allocation.AllocationSize.QuadPart = (LONGLONG)rotation_.segmentBytes;
+			SetFileInformationByHandle(hFile, FileAllocationInfo, &allocation, sizeof(allocation));
+		}
+		return true;
+	}
+	void RotatingFileDriver::Rotate_()
+	{
+		if (hFile_) {
+			CloseHandle(hFile_);
+			hFile_ = nullptr;
+		}
+		// shift archives up by one, dropping the oldest; failures leave files in place
+		// and are not fatal, the next segment is opened regardless
+		std::error_code ec;
+		if (rotation_.maxArchives == 0) {
+			std::filesystem::remove(path_, ec);
+		}
+		else {
+			std::filesystem::remove(GetArchivePath(rotation_.maxArchives), ec);
+			for (size_t i = rotation_.maxArchives - 1; i > 0; i--) {
+				std::filesystem::rename(GetArchivePath(i), GetArchivePath(i + 1), ec);
+			}
+			std::filesystem::rename(path_, GetArchivePath(1), ec);
+		}
+		// the archives have moved whether or not the new segment opens, so the size must not
+		// trigger another rotation; a segment that fails to open is retried by the next write
+		segmentSize_ = 0;
+		if (!OpenSegment_()) {
+			std::lock_guard lck{ mtx_ };
+			stats_.failedWrites++;
+		}
+	}
+	void RotatingFileDriver::Write_()
+	{
+		if (writing_.empty()) {
+			return;
+		}
+		if (segmentSize_ > 0 && (segmentSize_ + writing_.size() > rotation_.segmentBytes || IsSegmentExpired_())) {
+			Rotate_();
+			std::lock_guard lck{ mtx_ };
+			stats_.rotations++;
+		}
+		// WriteFile takes a 32-bit length
+		constexpr size_t maxChunk = 1 << 30;
+		bool failed = !hFile_ && !OpenSegment_();
+		for (size_t offset = 0; !failed && offset < writing_.size(); ) {
+			const auto chunk = (DWORD)std::min(writing_.size() - offset, maxChunk);
+			DWORD written = 0;
+			if (!WriteFile(hFile_, writing_.data() + offset, chunk, &written, nullptr) || written == 0) {
+				failed = true;
+				break;
+			}
+			offset += written;
+			segmentSize_ += written;
+		}
+		std::lock_guard lck{ mtx_ };
+		if (failed) {
+			// dropped rather than retried so that a broken disk cannot grow the buffer forever
+			stats_.failedWrites++;
+		}
+		else {
+			stats_.bytes += writing_.size();
+		}
+	}
+	bool RotatingFileDriver::IsSegmentExpired_() const
+	{
+		return rotation_.interval.count() > 0 &&
+			std::chrono::system_clock::now() - segmentStart_ >= rotation_.interval;
+	}
+	void RotatingFileDriver::WriterKernel_()
+	{
+		std::unique_lock lck{ mtx_ };
+		while (true) {
+			// sleep until the oldest entry is due, bounded so that interval rotation of an
+			// idle file is noticed within a commit interval
+			const auto deadline = (buffer_.empty() ? std::chrono::steady_clock::now() : oldestPending_)
+				+ rotation_.commitInterval;
+			wakeCv_.wait_until(lck, deadline, [this] {
+				return stopping_ || flushRequested_ != flushCompleted_ || buffer_.size() >= rotation_.commitBytes;
+			});
+			const bool stopping = stopping_;
+			const auto flushTicket = flushRequested_;
+			std::swap(buffer_, writing_);
+			lck.unlock();
+
+			Write_();
+			writing_.clear();
+			if (IsSegmentExpired_() && segmentSize_ > 0) {
+				Rotate_();
+				std::lock_guard statsLck{ mtx_ };
+				stats_.rotations++;
+			}
+			if ((flushTicket != flushCompleted_ || stopping) && hFile_) {
+				FlushFileBuffers(hFile_);
+			}
+
+			lck.lock();
+			flushCompleted_ = flushTicket;
+			flushedCv_.notify_all();
+			if (stopping && buffer_.empty()) {
+				return;
+			}
+		}
+	}
+}
\ No newline at end of file
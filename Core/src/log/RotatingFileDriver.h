@@ -0,0 +1,84 @@
+#pragma once
+#include "Driver.h"
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace chil::log
+{
+	class IRotatingFileDriver : public ITextDriver {};
+
+	// text file driver that rolls its file over to numbered archives (log.1.txt newest up to
+	// log.N.txt oldest) by size or by wall-clock age; every file operation, rotation
+	// included, runs on the driver's writer thread, so producers only append to a buffer
+	class RotatingFileDriver : public IRotatingFileDriver
+	{
+	public:
+		// types
+		struct Rotation
+		{
+			// size that triggers a rollover, also preallocated for each new segment; a
+			// segment can overshoot by one write batch since entries are never split
+			size_t segmentBytes = 64 << 20;
+			// wall-clock age that triggers a rollover; zero disables
+			std::chrono::minutes interval{ 0 };
+			// archives kept besides the active file; older ones are deleted
+			size_t maxArchives = 8;
+			// longest time an entry waits in the buffer before it is written
+			std::chrono::milliseconds commitInterval{ 200 };
+			// buffered bytes that wake the writer early
+			size_t commitBytes = 1 << 16;
+			// buffered bytes past which entries are dropped rather than blocking producers
+			size_t maxBacklogBytes = 16 << 20;
+		};
+		struct Stats
+		{
+			size_t entries = 0;
+			size_t dropped = 0;
+			size_t bytes = 0;
+			size_t rotations = 0;
+			size_t failedWrites = 0;
+		};
+		// functions
+		RotatingFileDriver(std::filesystem::path path, std::shared_ptr<ITextFormatter> pFormatter = {}, Rotation rotation = {});
+		~RotatingFileDriver();
+		void Submit(const Entry&) override;
+		void SetFormatter(std::shared_ptr<ITextFormatter> pFormatter) override;
+		// blocks until everything submitted so far has been written and synced
+		void Flush() override;
+		Stats GetStats() const;
+		std::uint64_t GetBytesWritten() const override;
+		std::filesystem::path GetArchivePath(size_t index) const;
+	private:
+		// functions
+		bool OpenSegment_();
+		void Rotate_();
+		void Write_();
+		bool IsSegmentExpired_() const;
+		void WriterKernel_();
+		// data
+		std::filesystem::path path_;
+		Rotation rotation_;
+		std::shared_ptr<ITextFormatter> pFormatter_;
+		mutable std::mutex mtx_;
+		std::condition_variable wakeCv_;
+		std::condition_variable flushedCv_;
+		std::string buffer_;
+		std::chrono::steady_clock::time_point oldestPending_;
+		size_t flushRequested_ = 0;
+		size_t flushCompleted_ = 0;
+		Stats stats_;
+		bool stopping_ = false;
+		// owned by the writer thread
+		std::string writing_;
+		// HANDLE, kept opaque so that the header does not pull in Windows.h
+		void* hFile_ = nullptr;
+		size_t segmentSize_ = 0;
+		std::chrono::system_clock::time_point segmentStart_;
+		std::thread writerThread_;
+	};
+}
\ No newline at end of file
@@ -12,4 +12,8 @@ namespace chil::log
 	{
 		return e.level_ <= level_;
 	}
+	Level SeverityLevelPolicy::GetMaxLevel() const
+	{
+		return level_;
+	}
 }
\ No newline at end of file
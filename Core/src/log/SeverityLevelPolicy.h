@@ -11,6 +11,7 @@ namespace chil::log
 	public:
 		SeverityLevelPolicy(Level level);
 		bool TransformFilter(Entry&) override;
+		Level GetMaxLevel() const override;
 	private:
 		Level level_;
 	};
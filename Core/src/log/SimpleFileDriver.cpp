@@ -9,13 +9,17 @@ namespace chil::log
 	{
 		// create any directories in the path that don't yet exist
 		std::filesystem::create_directories(path.parent_path());
-		// open file, append if already exists 
-		file_.open(path, file_.out | file_.app);
+		// open file, append if already exists; the text is written as UTF-8 bytes
+		file_.open(path, file_.out | file_.app | file_.binary);
 	}
 	void SimpleFileDriver::Submit(const Entry& e)
 	{
 		if (pFormatter_) {
-			file_ << pFormatter_->Format(e).c_str();
+			thread_local std::string buffer;
+			buffer.clear();
+			pFormatter_->FormatUtf8To(buffer, e);
+			file_.write(buffer.data(), std::streamsize(buffer.size()));
+			bytesWritten_.fetch_add(buffer.size(), std::memory_order_relaxed);
 		}
 		// TODO: how to log stuff from log system 
 	}
@@ -27,4 +31,8 @@ namespace chil::log
 	{
 		file_.flush();
 	}
+	std::uint64_t SimpleFileDriver::GetBytesWritten() const
+	{
+		return bytesWritten_.load(std::memory_order_relaxed);
+	}
 }
\ No newline at end of file
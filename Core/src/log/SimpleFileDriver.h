@@ -1,5 +1,6 @@
 #pragma once 
 #include "Driver.h" 
+#include <atomic> 
 #include <memory> 
 #include <filesystem> 
 #include <fstream> 
@@ -15,8 +16,10 @@ namespace chil::log
 		void Submit(const Entry&) override;
 		void SetFormatter(std::shared_ptr<ITextFormatter> pFormatter) override;
 		void Flush() override;
+		std::uint64_t GetBytesWritten() const override;
 	private:
-		std::wofstream file_;
+		std::ofstream file_;
+		std::atomic<std::uint64_t> bytesWritten_ = 0;
 		std::shared_ptr<ITextFormatter> pFormatter_;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "Site.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace chil::log
+{
+	namespace
+	{
+		// constant-initialized, so sites reached during static initialization are safe
+		constinit std::atomic<StaticSite*> pRegistryHead = nullptr;
+	}
+
+	Site::Site(const wchar_t* file, const wchar_t* function, int line, Level level)
+		:
+		file_{ file },
+		function_{ function },
+		line_{ line },
+		level_{ level }
+	{}
+	const wchar_t* Site::GetFile() const
+	{
+		return file_;
+	}
+	const wchar_t* Site::GetFunction() const
+	{
+		return function_;
+	}
+	int Site::GetLine() const
+	{
+		return line_;
+	}
+	Level Site::GetLevel() const
+	{
+		return level_;
+	}
+	void Site::SetEnabled(bool enabled)
+	{
+		enabled_.store(enabled, std::memory_order_relaxed);
+	}
+
+	StaticSite::StaticSite(const wchar_t* file, const wchar_t* function, int line, Level level)
+		:
+		Site{ file, function, line, level }
+	{
+		// push onto the intrusive list; sites are never unregistered
+		pNext_ = pRegistryHead.load(std::memory_order_relaxed);
+		while (!pRegistryHead.compare_exchange_weak(pNext_, this,
+			std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	void ForEachSite(const std::function<void(StaticSite&)>& visitor)
+	{
+		for (auto pSite = pRegistryHead.load(std::memory_order_acquire); pSite; pSite = pSite->pNext_) {
+			visitor(*pSite);
+		}
+	}
+	size_t SetSitesEnabled(std::wstring_view fileSuffix, int line, bool enabled)
+	{
+		size_t count = 0;
+		ForEachSite([&](StaticSite& site) {
+			if ((line < 0 || site.GetLine() == line) && site.GetFile() &&
+				std::wstring_view{ site.GetFile() }.ends_with(fileSuffix)) {
+				site.SetEnabled(enabled);
+				count++;
+			}
+		});
+		return count;
+	}
+	const Site& InternSite(const wchar_t* file, const wchar_t* function, int line)
+	{
+		// keyed by content because dynamic callers may pass non-literal strings; the strings
+		// are copied so that the site can outlive them
+		struct Interned
+		{
+			std::wstring file;
+			std::wstring function;
+			StaticSite site;
+			Interned(std::wstring fileName, std::wstring functionName, int line)
+				:
+				file{ std::move(fileName) },
+				function{ std::move(functionName) },
+				site{ file.c_str(), function.c_str(), line }
+			{}
+		};
+		using Key = std::tuple<std::wstring_view, std::wstring_view, int>;
+		static std::mutex mtx;
+		static std::map<Key, std::unique_ptr<Interned>> sites;
+
+		const Key key{ file ? file : L"", function ? function : L"", line };
+		std::lock_guard lk{ mtx };
+		if (auto i = sites.find(key); i != sites.end()) {
+			return i->second->site;
+		}
+		auto pInterned = std::make_unique<Interned>(std::wstring{ std::get<0>(key) }, std::wstring{ std::get<1>(key) }, line);
+		auto& site = pInterned->site;
+		sites.emplace(Key{ pInterned->file, pInterned->function, line }, std::move(pInterned));
+		return site;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include "Level.h"
+#include <atomic>
+#include <functional>
+#include <string_view>
+
+namespace chil::log
+{
+	// descriptor of one logging call site; entries refer to their site by pointer, so a
+	// site must outlive every entry that was built from it
+	class Site
+	{
+	public:
+		Site(const wchar_t* file, const wchar_t* function, int line, Level level = Level::Error);
+		Site(const Site&) = delete;
+		Site& operator=(const Site&) = delete;
+		const wchar_t* GetFile() const;
+		const wchar_t* GetFunction() const;
+		int GetLine() const;
+		// level given to entries from this site unless the builder sets one
+		Level GetLevel() const;
+		// checked on every entry, kept inline so that the hot path is a single relaxed load
+		bool IsEnabled() const
+		{
+			return enabled_.load(std::memory_order_relaxed);
+		}
+		void SetEnabled(bool enabled);
+	private:
+		const wchar_t* file_;
+		const wchar_t* function_;
+		int line_;
+		Level level_;
+		std::atomic<bool> enabled_ = true;
+	};
+
+	// site with static storage duration (emitted by the chilog macros) that adds itself to
+	// the process-wide registry when first reached
+	class StaticSite : public Site
+	{
+		friend void ForEachSite(const std::function<void(StaticSite&)>&);
+	public:
+		StaticSite(const wchar_t* file, const wchar_t* function, int line, Level level = Level::Error);
+	private:
+		StaticSite* pNext_ = nullptr;
+	};
+
+	// visits every registered site that has been reached so far; safe to call while other
+	// threads are registering sites
+	void ForEachSite(const std::function<void(StaticSite&)>& visitor);
+	// enables/disables registered sites whose file path ends with fileSuffix, at the given
+	// line or at any line when line is negative; returns the number of sites matched
+	size_t SetSitesEnabled(std::wstring_view fileSuffix, int line, bool enabled);
+	// registered site for a location that is not a literal call site (assertions, tools);
+	// looked up under a lock, so not for hot paths
+	const Site& InternSite(const wchar_t* file, const wchar_t* function, int line);
+}
+
+// expands to a reference to a function-local static site for the expansion point; the
+// enclosing function name is passed in because inside the lambda it would name the lambda
+#define ZZ_LOG_SITE_(lvl) [](const wchar_t* function) -> const chil::log::Site& { \
+	static chil::log::StaticSite site{ __FILEW__, function, __LINE__, lvl }; \
+	return site; }(__FUNCTIONW__)
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+
+namespace chil::log
+{
+	class Site;
+
+	// fixed open-addressed table of per-site state keyed by site address, for policies that
+	// look a site up on every entry; a slot is claimed with a CAS on its pSite member (a
+	// std::atomic<const Site*> that starts out null) and never released, so lookups take no
+	// lock. sites whose probe sequence is full get no slot
+	template<typename Slot>
+	class SiteTable
+	{
+	public:
+		// capacity is rounded up to a power of two
+		SiteTable(size_t capacity)
+			:
+			mask_{ std::bit_ceil(std::max<size_t>(capacity, 1)) - 1 },
+			slots_{ std::make_unique<Slot[]>(mask_ + 1) }
+		{}
+		// slot holding the site, claiming a free one the first time the site is seen;
+		// nullptr when the table has no room for it
+		Slot* Find(const Site* pSite)
+		{
+			// fibonacci hashing of the address; the high bits are the well-mixed ones
+			const auto hash = size_t((std::uint64_t(std::uintptr_t(pSite)) * 0x9E3779B97F4A7C15ull) >> 32);
+			const auto probes = std::min(maxProbes_, mask_ + 1);
+			for (size_t i = 0; i < probes; i++) {
+				auto& slot = slots_[(hash + i) & mask_];
+				auto pOccupant = slot.pSite.load(std::memory_order_acquire);
+				if (!pOccupant && slot.pSite.compare_exchange_strong(pOccupant, pSite, std::memory_order_acq_rel)) {
+					return &slot;
+				}
+				if (pOccupant == pSite) {
+					return &slot;
+				}
+			}
+			return nullptr;
+		}
+		// calls visitor(slot, pSite) for every claimed slot
+		template<typename F>
+		void ForEach(F&& visitor)
+		{
+			for (size_t i = 0; i <= mask_; i++) {
+				if (const auto pSite = slots_[i].pSite.load(std::memory_order_acquire)) {
+					visitor(slots_[i], pSite);
+				}
+			}
+		}
+	private:
+		// constants
+		static constexpr size_t maxProbes_ = 32;
+		// data
+		size_t mask_;
+		std::unique_ptr<Slot[]> slots_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "StagedChannel.h"
+#include "Driver.h"
+#include "Policy.h"
+#include <algorithm>
+
+namespace chil::log
+{
+	namespace
+	{
+		std::atomic<std::uint64_t> nextChannelId = 1;
+
+		// min-heap on timestamp
+		constexpr auto later = [](const auto& a, const auto& b) { return a.first > b.first; };
+	}
+
+	StagedChannel::Handle::Handle(std::uint64_t channelId, std::shared_ptr<Buffer> pBuffer)
+		:
+		channelId{ channelId },
+		pBuffer{ std::move(pBuffer) }
+	{}
+	StagedChannel::Handle::~Handle()
+	{
+		if (pBuffer) {
+			pBuffer->orphaned.store(true, std::memory_order_release);
+		}
+	}
+
+	StagedChannel::StagedChannel(std::vector<std::shared_ptr<IDriver>> driverPtrs, Staging staging)
+		:
+		id_{ nextChannelId.fetch_add(1, std::memory_order_relaxed) },
+		staging_{ staging },
+		channel_{ std::move(driverPtrs) },
+		collectorThread_{ &StagedChannel::CollectorKernel_, this }
+	{}
+	StagedChannel::~StagedChannel()
+	{
+		{
+			std::lock_guard lck{ wakeMtx_ };
+			stopping_ = true;
+			wake_ = true;
+		}
+		wakeCv_.notify_one();
+		collectorThread_.join();
+		// threads still holding handles to this channel drop them the next time they
+		// register with a channel
+		std::lock_guard lck{ registryMtx_ };
+		for (auto& pBuffer : registry_) {
+			pBuffer->closed.store(true, std::memory_order_release);
+		}
+	}
+	void StagedChannel::Submit(Entry& e)
+	{
+		// entries raised while dispatching (from a driver, say) go straight through, since
+		// the collector cannot wait on itself
+		if (std::this_thread::get_id() == collectorThread_.get_id()) {
+			channel_.Submit(e);
+			return;
+		}
+		auto& buffer = GetBuffer_();
+		if (buffer.queue.TryPush(std::move(e))) {
+			return;
+		}
+		// the round is only read once the buffer is found full, so that the fast path does
+		// not touch the collector's cache line; a round that freed space between the failed
+		// push and this read is caught by trying once more
+		auto round = mergeRound_.load(std::memory_order_acquire);
+		if (buffer.queue.TryPush(std::move(e))) {
+			return;
+		}
+		// the collector is behind: nudge it once rather than waiting out its interval, then
+		// sleep until a merge round has run and try again (entries still inside the hold-back
+		// can keep the buffer full for a round or two). until this entry is staged, rounds
+		// leave entries stamped after it alone
+		const auto stamp = e.timestamp_;
+		buffer.blockedStamp.store(stamp, std::memory_order_seq_cst);
+		Wake_();
+		do {
+			// pairs with the waiter check after each round: either this wait sees the new
+			// round, or the collector sees the waiter and notifies
+			fullWaiterCount_.fetch_add(1, std::memory_order_seq_cst);
+			mergeRound_.wait(round, std::memory_order_seq_cst);
+			fullWaiterCount_.fetch_sub(1, std::memory_order_relaxed);
+			round = mergeRound_.load(std::memory_order_acquire);
+		} while (!buffer.queue.TryPush(std::move(e)));
+		buffer.blockedStamp.store(Clock::time_point::max(), std::memory_order_release);
+	}
+	void StagedChannel::Flush()
+	{
+		if (std::this_thread::get_id() == collectorThread_.get_id()) {
+			channel_.Flush();
+			return;
+		}
+		// the ticket is taken after this thread's entries were staged, so the round that
+		// serves it sees them
+		const auto ticket = flushTicket_.fetch_add(1) + 1;
+		Wake_();
+		for (auto flushed = flushedTicket_.load(std::memory_order_acquire); flushed < ticket;
+			flushed = flushedTicket_.load(std::memory_order_acquire)) {
+			flushedTicket_.wait(flushed, std::memory_order_acquire);
+		}
+	}
+	void StagedChannel::AttachDriver(std::shared_ptr<IDriver> pDriver)
+	{
+		channel_.AttachDriver(std::move(pDriver));
+	}
+	void StagedChannel::AttachPolicy(std::shared_ptr<IPolicy> pPolicy)
+	{
+		channel_.AttachPolicy(std::move(pPolicy));
+	}
+	bool StagedChannel::AcceptsLevel(Level level) const
+	{
+		return channel_.AcceptsLevel(level);
+	}
+	ChannelStats StagedChannel::GetStats() const
+	{
+		return channel_.GetStats();
+	}
+	StagedChannel::Buffer& StagedChannel::GetBuffer_()
+	{
+		// a thread usually logs to one or two channels, so a short list beats a map
+		thread_local std::vector<Handle> handles;
+		for (auto& handle : handles) {
+			if (handle.channelId == id_) {
+				return *handle.pBuffer;
+			}
+		}
+		// first entry from this thread: forget channels that are gone, then register
+		std::erase_if(handles, [](const Handle& h) { return h.pBuffer->closed.load(std::memory_order_acquire); });
+		auto pBuffer = std::make_shared<Buffer>(staging_.capacity);
+		{
+			std::lock_guard lck{ registryMtx_ };
+			registry_.push_back(pBuffer);
+			registryVersion_.fetch_add(1, std::memory_order_release);
+		}
+		return *handles.emplace_back(id_, std::move(pBuffer)).pBuffer;
+	}
+	void StagedChannel::Wake_()
+	{
+		{
+			std::lock_guard lck{ wakeMtx_ };
+			wake_ = true;
+		}
+		wakeCv_.notify_one();
+	}
+	void StagedChannel::Merge_(Clock::time_point horizon, bool holdForBlocked)
+	{
+		if (const auto version = registryVersion_.load(std::memory_order_acquire); version != activeVersion_) {
+			std::lock_guard lck{ registryMtx_ };
+			active_ = registry_;
+			activeVersion_ = version;
+		}
+		// a producer waiting on a full buffer has an entry that is not staged yet; nothing
+		// stamped after it goes out before it does (the waiting buffer's own entries are all
+		// older, so merging them still frees it)
+		if (holdForBlocked) {
+			for (auto& pBuffer : active_) {
+				horizon = std::min(horizon, pBuffer->blockedStamp.load(std::memory_order_acquire));
+			}
+		}
+		// k-way merge over the oldest due entry of each buffer; a thread's own entries are
+		// already in timestamp order, so only the heads need comparing
+		heap_.clear();
+		for (auto& pBuffer : active_) {
+			if (const auto pEntry = pBuffer->queue.Front(); pEntry && pEntry->timestamp_ <= horizon) {
+				heap_.emplace_back(pEntry->timestamp_, pBuffer.get());
+			}
+		}
+		std::ranges::make_heap(heap_, later);
+		while (!heap_.empty()) {
+			std::ranges::pop_heap(heap_, later);
+			const auto pBuffer = heap_.back().second;
+			heap_.pop_back();
+			channel_.Submit(*pBuffer->queue.Front());
+			pBuffer->queue.Pop();
+			if (const auto pEntry = pBuffer->queue.Front(); pEntry && pEntry->timestamp_ <= horizon) {
+				heap_.emplace_back(pEntry->timestamp_, pBuffer);
+				std::ranges::push_heap(heap_, later);
+			}
+		}
+		// buffers of threads that have exited go once they are drained; the orphaned flag is
+		// read first, so nothing can be staged after the emptiness check
+		const auto drained = [](const std::shared_ptr<Buffer>& pBuffer) {
+			return pBuffer->orphaned.load(std::memory_order_acquire) && pBuffer->queue.IsEmpty();
+		};
+		if (std::ranges::any_of(active_, drained)) {
+			std::lock_guard lck{ registryMtx_ };
+			std::erase_if(registry_, drained);
+			std::erase_if(active_, drained);
+		}
+	}
+	void StagedChannel::CollectorKernel_() noexcept
+	{
+		std::unique_lock lck{ wakeMtx_ };
+		while (true) {
+			wakeCv_.wait_for(lck, staging_.interval, [this] { return wake_; });
+			wake_ = false;
+			const bool stopping = stopping_;
+			lck.unlock();
+			const auto ticket = flushTicket_.load(std::memory_order_acquire);
+			const bool flushing = ticket != flushedTicket_.load(std::memory_order_relaxed);
+			// a flush releases everything stamped before it was requested
+			const auto now = Clock::now();
+			// flushes are not held for blocked producers, so that a flush never returns with
+			// the flushing thread's own entries still staged
+			if (stopping) {
+				Merge_(Clock::time_point::max(), false);
+			}
+			else {
+				Merge_(flushing ? now : now - staging_.holdback, !flushing);
+			}
+			mergeRound_.fetch_add(1, std::memory_order_seq_cst);
+			if (fullWaiterCount_.load(std::memory_order_seq_cst) != 0) {
+				mergeRound_.notify_all();
+			}
+			if (flushing || stopping) {
+				channel_.Flush();
+				flushedTicket_.store(ticket, std::memory_order_release);
+				flushedTicket_.notify_all();
+			}
+			if (stopping) {
+				break;
+			}
+			lck.lock();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+#include "Channel.h"
+#include "Entry.h"
+#include <Core/src/ccr/SpscQueue.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chil::log
+{
+	// channel where each producer thread stages entries in a ring of its own, and a
+	// collector thread periodically merges the rings by timestamp into the policies and
+	// drivers; a producer only writes its own ring, so threads do not contend with each
+	// other, and drivers are only ever called from the collector thread
+	//
+	// entries younger than the hold-back are left staged for a later round, so that one
+	// stamped just before a round but staged just after it is still merged in order.
+	// output is globally ordered unless a thread is stalled for longer than the hold-back
+	// between building an entry and submitting it (waiting on a full buffer does not count:
+	// while a producer waits, later entries of other threads are held back too)
+	class StagedChannel : public IChannel
+	{
+	public:
+		// types
+		struct Staging
+		{
+			// entries each producer thread can stage before it has to wait for the collector
+			size_t capacity = 4096;
+			// time between merge rounds
+			std::chrono::milliseconds interval{ 2 };
+			std::chrono::milliseconds holdback{ 2 };
+		};
+		// functions
+		StagedChannel(std::vector<std::shared_ptr<IDriver>> driverPtrs = {}, Staging staging = {});
+		~StagedChannel();
+		void Submit(Entry&) override;
+		// blocks until every entry staged before the call has reached the drivers, regardless
+		// of the hold-back
+		void Flush() override;
+		void AttachDriver(std::shared_ptr<IDriver>) override;
+		void AttachPolicy(std::shared_ptr<IPolicy>) override;
+		bool AcceptsLevel(Level) const override;
+		ChannelStats GetStats() const override;
+	private:
+		// types
+		struct Buffer
+		{
+			Buffer(size_t capacity) : queue{ capacity } {}
+			ccr::SpscQueue<Entry> queue;
+			// the producer thread has exited; dropped once drained
+			std::atomic<bool> orphaned = false;
+			// the channel is gone; the thread drops its handle
+			std::atomic<bool> closed = false;
+			// timestamp of the entry the producer is waiting to stage while the buffer is
+			// full; max when it is not waiting
+			std::atomic<Clock::time_point> blockedStamp = Clock::time_point::max();
+		};
+		// a producer thread's reference to its buffer in one channel
+		struct Handle
+		{
+			Handle(std::uint64_t channelId, std::shared_ptr<Buffer> pBuffer);
+			Handle(Handle&&) = default;
+			Handle& operator=(Handle&&) = default;
+			~Handle();
+			std::uint64_t channelId;
+			std::shared_ptr<Buffer> pBuffer;
+		};
+		// functions
+		Buffer& GetBuffer_();
+		void Wake_();
+		void Merge_(Clock::time_point horizon, bool holdForBlocked);
+		void CollectorKernel_() noexcept;
+		// data
+		// identifies the channel in thread-local handles (an address could be reused)
+		const std::uint64_t id_;
+		const Staging staging_;
+		Channel channel_;
+		// every buffer, added to by producers the first time they log
+		std::mutex registryMtx_;
+		std::vector<std::shared_ptr<Buffer>> registry_;
+		std::atomic<size_t> registryVersion_ = 0;
+		// collector's copy of the registry and merge heap
+		std::vector<std::shared_ptr<Buffer>> active_;
+		size_t activeVersion_ = 0;
+		std::vector<std::pair<Clock::time_point, Buffer*>> heap_;
+		// flush requests and wake-ups (a full buffer, shutdown)
+		std::atomic<std::uint64_t> flushTicket_ = 0;
+		std::atomic<std::uint64_t> flushedTicket_ = 0;
+		std::mutex wakeMtx_;
+		std::condition_variable wakeCv_;
+		bool wake_ = false;
+		bool stopping_ = false;
+		// producers with a full buffer sleep on the round count, which the collector bumps
+		// after every merge round (notifying only when someone is asleep)
+		std::atomic<std::uint32_t> mergeRound_ = 0;
+		std::atomic<size_t> fullWaiterCount_ = 0;
+		std::thread collectorThread_;
+	};
+}
\ No newline at end of file
@@ -2,36 +2,191 @@
 #include "TextFormatter.h"
 #include "Entry.h"
 #include <format>
-#include <sstream>
+#include <iterator>
+#include <Core/src/utl/String.h>
 #include <Core/src/win/Utilities.h>
 
 namespace chil::log
 {
-	std::wstring TextFormatter::Format(const Entry& e) const
+	namespace
 	{
-		std::wostringstream oss;
-		oss << std::format(L"@{} {{{}}} {}",
-			GetLevelName(e.level_),
-			std::chrono::zoned_time{ std::chrono::current_zone(), e.timestamp_ },
-			e.note_
-		);
-		if (e.hResult_) {
-			oss << std::format(L"\n  !HRESULT [{:#010x}]: {}", *e.hResult_,
-				win::GetErrorDescription(*e.hResult_));
+		// format strings for each output character type, so that one routine produces both
+		// wide and UTF-8 text
+		template<typename C> struct Formats;
+		template<> struct Formats<wchar_t>
+		{
+			static constexpr std::wstring_view dateTime = L"{:%F %T}";
+			static constexpr std::wstring_view zone = L" {:%Z}";
+			static constexpr std::wstring_view subseconds = L".{:0{}}";
+			static constexpr std::wstring_view value = L"{}";
+			static constexpr std::wstring_view hResult = L"{:#010x}";
+		};
+		template<> struct Formats<char>
+		{
+			static constexpr std::string_view dateTime = "{:%F %T}";
+			static constexpr std::string_view zone = " {:%Z}";
+			static constexpr std::string_view subseconds = ".{:0{}}";
+			static constexpr std::string_view value = "{}";
+			static constexpr std::string_view hResult = "{:#010x}";
+		};
+
+		// ASCII punctuation, widened as it is appended
+		template<typename C>
+		void Put(std::basic_string<C>& out, std::string_view ascii)
+		{
+			out.append(ascii.begin(), ascii.end());
+		}
+		// text that is wide at its source (site strings, OS messages), transcoded for UTF-8
+		void Put(std::wstring& out, std::wstring_view text)
+		{
+			out += text;
+		}
+		void Put(std::string& out, std::wstring_view text)
+		{
+			utl::AppendUtf8(out, text);
+		}
+		void Put(std::wstring& out, std::u8string_view text)
+		{
+			utl::AppendWide(out, utl::AsChars(text));
 		}
-		if (e.showSourceLine_.value_or(true)) {
-			oss << std::format(L"\n  >> at {}\n     {}({})\n",
-				e.sourceFunctionName_,
-				e.sourceFile_,
-				e.sourceLine_
-			);
+		void Put(std::string& out, std::u8string_view text)
+		{
+			out += utl::AsChars(text);
 		}
-		else {
-			oss << "\n";
+
+		// the zone is resolved once per process; the date/time text is reused while entries
+		// stay within the same second, and only the sub-second digits are formatted per entry
+		template<typename C>
+		class TimestampCache
+		{
+		public:
+			void FormatTo(std::basic_string<C>& out, std::chrono::system_clock::time_point timestamp)
+			{
+				using namespace std::chrono;
+				const auto second = floor<seconds>(timestamp);
+				if (second != second_ || prefix_.empty()) {
+					const zoned_time local{ GetZone_(), second };
+					prefix_.clear();
+					std::format_to(std::back_inserter(prefix_), Formats<C>::dateTime, local);
+					suffix_.clear();
+					std::format_to(std::back_inserter(suffix_), Formats<C>::zone, local);
+					second_ = second;
+				}
+				out += prefix_;
+				constexpr auto width = hh_mm_ss<system_clock::duration>::fractional_width;
+				if constexpr (width > 0) {
+					const hh_mm_ss time{ timestamp - second };
+					std::format_to(std::back_inserter(out), Formats<C>::subseconds, time.subseconds().count(), width);
+				}
+				out += suffix_;
+			}
+		private:
+			static const std::chrono::time_zone* GetZone_()
+			{
+				static const auto pZone = std::chrono::current_zone();
+				return pZone;
+			}
+			std::chrono::sys_seconds second_{};
+			std::basic_string<C> prefix_;
+			std::basic_string<C> suffix_;
+		};
+
+		template<typename C>
+		void PutValue(std::basic_string<C>& out, const DeferredNote::Arg& arg)
+		{
+			const auto it = std::back_inserter(out);
+			switch (arg.kind) {
+			case DeferredNote::Kind::Signed: std::format_to(it, Formats<C>::value, arg.value.i); break;
+			case DeferredNote::Kind::Unsigned: std::format_to(it, Formats<C>::value, arg.value.u); break;
+			case DeferredNote::Kind::Float: std::format_to(it, Formats<C>::value, arg.value.f); break;
+			case DeferredNote::Kind::Bool: std::format_to(it, Formats<C>::value, arg.value.b); break;
+			case DeferredNote::Kind::Char: Put(out, std::wstring_view{ &arg.value.c, 1 }); break;
+			}
 		}
-		if (e.trace_) {
-			oss << e.trace_->Print() << "\n";
+
+		template<typename C>
+		void FormatEntry(std::basic_string<C>& out, const Entry& e)
+		{
+			thread_local TimestampCache<C> timestampCache;
+			const auto it = std::back_inserter(out);
+
+			Put(out, "@");
+			Put(out, GetLevelName(e.level_));
+			Put(out, " {");
+			timestampCache.FormatTo(out, Clock::ToSystem(e.timestamp_));
+			Put(out, "} ");
+			if (e.deferredNote_) {
+				if constexpr (std::same_as<C, wchar_t>) {
+					e.deferredNote_->ExpandTo(out);
+				}
+				else {
+					thread_local std::wstring note;
+					note.clear();
+					e.deferredNote_->ExpandTo(note);
+					Put(out, note);
+				}
+			}
+			else if (!e.noteUtf8_.empty()) {
+				Put(out, std::u8string_view{ e.noteUtf8_ });
+			}
+			else {
+				Put(out, std::wstring_view{ e.note_ });
+			}
+			if (e.fields_ && !e.fields_->IsEmpty()) {
+				auto separator = " (";
+				for (const auto& field : e.fields_->Get()) {
+					Put(out, separator);
+					Put(out, field.key);
+					Put(out, "=");
+					if (field.isText) {
+						Put(out, e.fields_->GetText(field));
+					}
+					else {
+						PutValue(out, field.value);
+					}
+					separator = ", ";
+				}
+				Put(out, ")");
+			}
+			if (e.hResult_) {
+				Put(out, "\n  !HRESULT [");
+				std::format_to(it, Formats<C>::hResult, *e.hResult_);
+				Put(out, "]: ");
+				Put(out, win::GetErrorDescription(*e.hResult_));
+			}
+			if (e.pSite_ && e.showSourceLine_.value_or(true)) {
+				Put(out, "\n  >> at ");
+				Put(out, e.pSite_->GetFunction());
+				Put(out, "\n     ");
+				Put(out, e.pSite_->GetFile());
+				Put(out, "(");
+				std::format_to(it, Formats<C>::value, e.pSite_->GetLine());
+				Put(out, ")\n");
+			}
+			else {
+				Put(out, "\n");
+			}
+			if (e.trace_) {
+				Put(out, e.trace_->Print());
+				Put(out, "\n");
+			}
 		}
-		return oss.str();
+	}
+
+	void ITextFormatter::FormatUtf8To(std::string& out, const Entry& e) const
+	{
+		thread_local std::wstring wide;
+		wide.clear();
+		FormatTo(wide, e);
+		utl::AppendUtf8(out, wide);
+	}
+
+	void TextFormatter::FormatTo(std::wstring& out, const Entry& e) const
+	{
+		FormatEntry(out, e);
+	}
+	void TextFormatter::FormatUtf8To(std::string& out, const Entry& e) const
+	{
+		FormatEntry(out, e);
 	}
 }
\ No newline at end of file
@@ -9,12 +9,31 @@ namespace chil::log
 	{
 	public:
 		virtual ~ITextFormatter() = default;
-		virtual std::wstring Format(const Entry&) const = 0;
+		// appends the formatted entry to out; drivers keep one buffer per thread and clear
+		// it between entries, so that formatting does not allocate in steady state
+		virtual void FormatTo(std::wstring& out, const Entry&) const = 0;
+		// appends the formatted entry to out as UTF-8 bytes, for drivers that write bytes;
+		// the default transcodes the output of FormatTo, formatters that can produce UTF-8
+		// directly should override it
+		virtual void FormatUtf8To(std::string& out, const Entry&) const;
+		std::wstring Format(const Entry& e) const
+		{
+			std::wstring text;
+			FormatTo(text, e);
+			return text;
+		}
+		std::string FormatUtf8(const Entry& e) const
+		{
+			std::string text;
+			FormatUtf8To(text, e);
+			return text;
+		}
 	};
 
 	class TextFormatter : public ITextFormatter
 	{
 	public:
-		std::wstring Format(const Entry&) const override;
+		void FormatTo(std::wstring& out, const Entry&) const override;
+		void FormatUtf8To(std::string& out, const Entry&) const override;
 	};
 }
\ No newline at end of file
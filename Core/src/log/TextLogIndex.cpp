@@ -0,0 +1,385 @@
+#include "TextLogIndex.h"
+#include "BinaryFormat.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
+namespace chil::log
+{
+	namespace
+	{
+		// sidecar layout: a fixed header, then a stream of records, each a varint length
+		// followed by a body whose first byte is the record type:
+		//   File:  path                             (ids are implicit, in order from 1)
+		//   Entry: dOffset size level dTicks file line
+		// offsets and timestamps are deltas from the previous entry
+		constexpr char magic[4] = { 'C', 'H', 'T', 'X' };
+		constexpr std::uint32_t version = 1;
+		struct IndexHeader
+		{
+			char magic[4];
+			std::uint32_t version;
+			std::uint64_t covered;
+			std::uint64_t indexBytes;
+			std::uint32_t fingerprint;
+			std::uint32_t reserved;
+		};
+		enum class RecordType : std::uint8_t
+		{
+			File = 1,
+			Entry = 2,
+		};
+		// enough of the log to tell it apart from its successor after a rotation
+		constexpr size_t fingerprintSize = 4096;
+
+		std::uint32_t Fingerprint(std::string_view data, std::uint64_t covered)
+		{
+			return bin::Checksum(data.substr(0, size_t(std::min<std::uint64_t>(covered, fingerprintSize))));
+		}
+
+		struct EntryHeader
+		{
+			Level level;
+			utl::LocalTime time;
+		};
+		// parses "@Level {timestamp zone}" at the start of text
+		std::optional<EntryHeader> ParseEntryHeader(std::string_view text)
+		{
+			static const auto levels = [] {
+				std::array<std::pair<std::string, Level>, 6> levels;
+				for (int i = 0; i < int(levels.size()); i++) {
+					const auto level = Level(int(Level::Fatal) + i);
+					const auto name = GetLevelName(level);
+					levels[i] = { std::string(name.begin(), name.end()), level };
+				}
+				return levels;
+			}();
+			if (!text.starts_with('@')) {
+				return std::nullopt;
+			}
+			const auto nameEnd = text.find(' ');
+			if (nameEnd == text.npos || text.substr(nameEnd).substr(0, 2) != " {") {
+				return std::nullopt;
+			}
+			const auto name = text.substr(1, nameEnd - 1);
+			const auto i = std::ranges::find(levels, name, &std::pair<std::string, Level>::first);
+			if (i == levels.end()) {
+				return std::nullopt;
+			}
+			const auto time = utl::ParseLocalTime(text.substr(nameEnd + 2));
+			if (!time) {
+				return std::nullopt;
+			}
+			return EntryHeader{ i->second, *time };
+		}
+		// finds the line of the next entry header at or after pos (which must be at the start
+		// of a line); npos when there is none
+		size_t FindEntry(std::string_view data, size_t pos)
+		{
+			while (pos < data.size()) {
+				if (data[pos] == '@' && ParseEntryHeader(data.substr(pos, 64))) {
+					return pos;
+				}
+				pos = data.find('\n', pos);
+				if (pos == data.npos) {
+					break;
+				}
+				pos++;
+			}
+			return data.npos;
+		}
+		// extracts "file(line)" from the line following "\n  >> at function"
+		bool ParseSourceLine(std::string_view text, std::string_view& file, int& line)
+		{
+			const auto at = text.find("\n  >> at ");
+			if (at == text.npos) {
+				return false;
+			}
+			const auto start = text.find('\n', at + 1);
+			if (start == text.npos) {
+				return false;
+			}
+			auto source = text.substr(start + 1);
+			source = source.substr(0, source.find('\n'));
+			const auto open = source.rfind('(');
+			if (!source.starts_with("     ") || !source.ends_with(')') || open == source.npos || open < 5) {
+				return false;
+			}
+			const auto digits = source.substr(open + 1, source.size() - open - 2);
+			const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), line);
+			if (ec != std::errc{} || end != digits.data() + digits.size()) {
+				return false;
+			}
+			file = source.substr(5, open - 5);
+			return true;
+		}
+		bool EndsWithPath(std::string_view path, std::string_view suffix)
+		{
+			if (suffix.size() > path.size()) {
+				return false;
+			}
+			const auto tail = path.substr(path.size() - suffix.size());
+			const auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c; };
+			if (!std::ranges::equal(tail, suffix, {}, lower, lower)) {
+				return false;
+			}
+			// only whole path components match, so "p.cpp" does not match "App.cpp"
+			const auto boundary = path.size() - suffix.size();
+			return boundary == 0 || path[boundary - 1] == '\\' || path[boundary - 1] == '/' ||
+				suffix.starts_with('\\') || suffix.starts_with('/');
+		}
+	}
+
+	TextLogIndex::TextLogIndex(std::filesystem::path logPath)
+		:
+		indexPath_{ GetIndexPath(logPath) },
+		log_{ logPath }
+	{
+		Reset_();
+		if (log_.IsOpen()) {
+			Load_();
+		}
+	}
+	std::filesystem::path TextLogIndex::GetIndexPath(const std::filesystem::path& logPath)
+	{
+		auto path = logPath;
+		path += ".idx";
+		return path;
+	}
+	bool TextLogIndex::IsValid() const
+	{
+		return log_.IsOpen();
+	}
+	bool TextLogIndex::Update()
+	{
+		if (!log_.Remap()) {
+			return false;
+		}
+		const auto data = log_.GetData();
+		if (!Covers_(data)) {
+			Reset_();
+		}
+		// the tail entry is rescanned, since it may have grown
+		records_.resize(persisted_);
+		confirmed_ = persisted_;
+		Scan_(data);
+		return Persist_(data);
+	}
+	std::span<const TextLogIndex::Record> TextLogIndex::GetRecords() const
+	{
+		return records_;
+	}
+	std::string_view TextLogIndex::GetFile(const Record& record) const
+	{
+		return record.fileId < files_.size() ? std::string_view{ files_[record.fileId] } : std::string_view{};
+	}
+	std::string_view TextLogIndex::GetText(const Record& record) const
+	{
+		return log_.GetData().substr(size_t(record.offset), record.size);
+	}
+	std::vector<size_t> TextLogIndex::Find(const Query& query) const
+	{
+		// paths are matched once each rather than once per record
+		std::vector<char> fileMatches(files_.size(), query.file.empty());
+		if (!query.file.empty()) {
+			for (size_t i = 1; i < files_.size(); i++) {
+				fileMatches[i] = EndsWithPath(files_[i], query.file);
+			}
+		}
+		std::vector<size_t> indices;
+		for (size_t i = 0; i < records_.size(); i++) {
+			const auto& r = records_[i];
+			if (r.time >= query.from && r.time <= query.to && r.level <= query.level &&
+				fileMatches[r.fileId] && (query.line == 0 || r.line == query.line)) {
+				indices.push_back(i);
+			}
+		}
+		return indices;
+	}
+	size_t TextLogIndex::GetPersistedCount() const
+	{
+		return persisted_;
+	}
+	void TextLogIndex::Load_()
+	{
+		std::ifstream file{ indexPath_, std::ios::in | std::ios::binary };
+		const std::string index{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+		IndexHeader header;
+		if (index.size() < sizeof(header)) {
+			return;
+		}
+		std::memcpy(&header, index.data(), sizeof(header));
+		if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+			header.indexBytes > index.size() - sizeof(header)) {
+			return;
+		}
+		// a damaged sidecar is dropped and the log rescanned
+		bin::Cursor stream{ std::string_view{ index }.substr(sizeof(header), size_t(header.indexBytes)) };
+		std::string_view body;
+		std::uint64_t offset = 0;
+		std::int64_t ticks = 0;
+		while (stream.GetBytes(body)) {
+			bin::Cursor cursor{ body };
+			std::uint8_t type;
+			if (!cursor.GetU8(type)) {
+				Reset_();
+				return;
+			}
+			if (RecordType(type) == RecordType::File) {
+				files_.emplace_back(body.substr(1));
+				continue;
+			}
+			std::uint64_t dOffset, size, fileId;
+			std::int64_t dTicks, line;
+			std::uint8_t level;
+			if (RecordType(type) != RecordType::Entry || !cursor.GetVarint(dOffset) || !cursor.GetVarint(size) ||
+				!cursor.GetU8(level) || !cursor.GetSigned(dTicks) || !cursor.GetVarint(fileId) ||
+				!cursor.GetSigned(line) || fileId >= files_.size()) {
+				Reset_();
+				return;
+			}
+			offset += dOffset;
+			ticks += dTicks;
+			records_.push_back({
+				.offset = offset,
+				.size = std::uint32_t(size),
+				.level = Level(level),
+				.fileId = std::uint32_t(fileId),
+				.line = int(line),
+				.time = utl::LocalTime{ utl::LocalTime::duration{ ticks } },
+			});
+		}
+		for (size_t i = 1; i < files_.size(); i++) {
+			fileIds_.emplace(files_[i], std::uint32_t(i));
+		}
+		persisted_ = confirmed_ = records_.size();
+		persistedFiles_ = files_.size();
+		indexBytes_ = header.indexBytes;
+		covered_ = header.covered;
+		fingerprint_ = header.fingerprint;
+		if (!Covers_(log_.GetData())) {
+			Reset_();
+		}
+	}
+	void TextLogIndex::Reset_()
+	{
+		records_.clear();
+		files_.assign(1, {});
+		fileIds_.clear();
+		persisted_ = confirmed_ = 0;
+		persistedFiles_ = 1;
+		indexBytes_ = 0;
+		covered_ = 0;
+		fingerprint_ = 0;
+	}
+	bool TextLogIndex::Covers_(std::string_view data) const
+	{
+		return covered_ <= data.size() && Fingerprint(data, covered_) == fingerprint_;
+	}
+	void TextLogIndex::Scan_(std::string_view data)
+	{
+		auto pos = FindEntry(data, size_t(covered_));
+		while (pos != data.npos) {
+			const auto lineEnd = data.find('\n', pos);
+			const auto next = lineEnd == data.npos ? data.npos : FindEntry(data, lineEnd + 1);
+			const auto end = next == data.npos ? data.size() : next;
+			const auto text = data.substr(pos, end - pos);
+			const auto header = ParseEntryHeader(text.substr(0, 64));
+			std::string_view file;
+			int line = 0;
+			const auto fileId = ParseSourceLine(text, file, line) ? InternFile_(file) : 0;
+			records_.push_back({
+				.offset = pos,
+				.size = std::uint32_t(std::min<size_t>(text.size(), UINT32_MAX)),
+				.level = header->level,
+				.fileId = fileId,
+				.line = line,
+				.time = header->time,
+			});
+			if (next != data.npos) {
+				confirmed_ = records_.size();
+			}
+			pos = next;
+		}
+	}
+	std::uint32_t TextLogIndex::InternFile_(std::string_view file)
+	{
+		const std::string key{ file };
+		if (const auto i = fileIds_.find(key); i != fileIds_.end()) {
+			return i->second;
+		}
+		const auto id = std::uint32_t(files_.size());
+		files_.push_back(key);
+		fileIds_.emplace(key, id);
+		return id;
+	}
+	bool TextLogIndex::Persist_(std::string_view data)
+	{
+		if (confirmed_ == persisted_) {
+			return true;
+		}
+		auto first = persisted_;
+		auto firstFile = persistedFiles_;
+		auto indexBytes = indexBytes_;
+		std::fstream file{ indexPath_, std::ios::in | std::ios::out | std::ios::binary };
+		if (!file || indexBytes == 0) {
+			// missing sidecar, or starting over: write it whole
+			file.close();
+			file.open(indexPath_, std::ios::out | std::ios::binary | std::ios::trunc);
+			first = 0;
+			firstFile = 1;
+			indexBytes = 0;
+		}
+		std::string stream;
+		std::string body;
+		for (size_t i = firstFile; i < files_.size(); i++) {
+			body.clear();
+			body.push_back(char(RecordType::File));
+			body += files_[i];
+			bin::PutBytes(stream, body);
+		}
+		std::uint64_t offset = first ? records_[first - 1].offset : 0;
+		std::int64_t ticks = first ? records_[first - 1].time.time_since_epoch().count() : 0;
+		for (size_t i = first; i < confirmed_; i++) {
+			const auto& r = records_[i];
+			body.clear();
+			body.push_back(char(RecordType::Entry));
+			bin::PutVarint(body, r.offset - offset);
+			bin::PutVarint(body, r.size);
+			body.push_back(char(r.level));
+			bin::PutSigned(body, r.time.time_since_epoch().count() - ticks);
+			bin::PutVarint(body, r.fileId);
+			bin::PutSigned(body, r.line);
+			bin::PutBytes(stream, body);
+			offset = r.offset;
+			ticks = r.time.time_since_epoch().count();
+		}
+		// records go in before the header that makes them visible
+		file.seekp(std::streamoff(sizeof(IndexHeader) + indexBytes));
+		file.write(stream.data(), std::streamsize(stream.size()));
+		const auto covered = confirmed_ < records_.size() ? records_[confirmed_].offset : std::uint64_t(data.size());
+		IndexHeader header{
+			.version = version,
+			.covered = covered,
+			.indexBytes = indexBytes + stream.size(),
+			.fingerprint = Fingerprint(data, covered),
+		};
+		std::memcpy(header.magic, magic, sizeof(magic));
+		file.seekp(0);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.flush();
+		if (!file) {
+			return false;
+		}
+		persisted_ = confirmed_;
+		persistedFiles_ = files_.size();
+		indexBytes_ = header.indexBytes;
+		covered_ = header.covered;
+		fingerprint_ = header.fingerprint;
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+#include "Level.h"
+#include <Core/src/utl/Time.h>
+#include <Core/src/win/MappedFile.h>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace chil::log
+{
+	// index over a text log written through TextFormatter (SimpleFileDriver and friends),
+	// kept in a sidecar file next to the log so that repeated queries do not rescan it
+	//
+	// entries are recognized by the "@Level {timestamp}" line that starts them and extend
+	// to the next such line; the source file and line come from the ">> at" trailer.
+	// timestamps are the local wall-clock time as printed, without the zone. the log is
+	// memory-mapped, and Update only scans what was appended since the last update. the
+	// last entry of the file is indexed in memory but not persisted, since it may still be
+	// in the middle of being written
+	class TextLogIndex
+	{
+	public:
+		// types
+		struct Record
+		{
+			std::uint64_t offset;
+			std::uint32_t size;
+			Level level;
+			// 0 when the entry has no source line
+			std::uint32_t fileId;
+			int line;
+			utl::LocalTime time;
+		};
+		struct Query
+		{
+			utl::LocalTime from = utl::LocalTime::min();
+			utl::LocalTime to = utl::LocalTime::max();
+			// matches entries at this severity or more severe (Error matches Error and Fatal)
+			Level level = Level::Verbose;
+			// matches source paths ending in this (a file name, or a trailing part of the
+			// path), ignoring ASCII case; empty matches any
+			std::string file;
+			// 0 matches any line
+			int line = 0;
+		};
+		// functions
+		TextLogIndex(std::filesystem::path logPath);
+		static std::filesystem::path GetIndexPath(const std::filesystem::path& logPath);
+		// false when the log file could not be opened
+		bool IsValid() const;
+		// indexes whatever was appended to the log and appends it to the sidecar; the index
+		// is rebuilt from scratch when the log was truncated or replaced. returns false when
+		// the sidecar could not be written, though the in-memory index is current regardless
+		bool Update();
+		std::span<const Record> GetRecords() const;
+		// source path of a record, as printed (UTF-8)
+		std::string_view GetFile(const Record& record) const;
+		// text of a record, read through the mapping
+		std::string_view GetText(const Record& record) const;
+		// indices of matching records, in file order
+		std::vector<size_t> Find(const Query& query) const;
+		// records covered by the sidecar (the rest were scanned by this instance)
+		size_t GetPersistedCount() const;
+	private:
+		// functions
+		void Load_();
+		void Reset_();
+		void Scan_(std::string_view data);
+		bool Covers_(std::string_view data) const;
+		std::uint32_t InternFile_(std::string_view file);
+		bool Persist_(std::string_view data);
+		// data
+		std::filesystem::path indexPath_;
+		win::MappedFile log_;
+		std::vector<Record> records_;
+		std::vector<std::string> files_;
+		std::unordered_map<std::string, std::uint32_t> fileIds_;
+		// records_[0, persisted_) and files_[0, persistedFiles_) are in the sidecar, whose
+		// record stream is indexBytes_ long and covers the log up to covered_ (the start of
+		// the first entry not persisted, where scanning resumes)
+		size_t persisted_ = 0;
+		size_t persistedFiles_ = 0;
+		std::uint64_t indexBytes_ = 0;
+		std::uint64_t covered_ = 0;
+		// checksum of the start of the log, to notice it being replaced (e.g. rotated)
+		std::uint32_t fingerprint_ = 0;
+		// records_[0, confirmed_) are followed by another entry, so they are complete
+		size_t confirmed_ = 0;
+	};
+}
\ No newline at end of file
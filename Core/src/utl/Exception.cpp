@@ -11,7 +11,7 @@ namespace chil::utl
 	{}
 	BufferedException::BufferedException(const std::wstring& msg)
 		:
-		message_{ ToNarrow(msg) }
+		message_{ ToUtf8(msg) }
 	{}
 	const char* BufferedException::what() const
 	{
@@ -23,4 +23,12 @@ namespace chil::utl
 		}
 		return buffer_.c_str();
 	}
+
+	std::wstring DescribeException(const std::exception& e)
+	{
+		if (dynamic_cast<const BufferedException*>(&e)) {
+			return FromUtf8(e.what());
+		}
+		return ToWide(e.what());
+	}
 }
\ No newline at end of file
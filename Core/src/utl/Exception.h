@@ -10,6 +10,7 @@ namespace chil::utl
 	{
 	public:
 		BufferedException() = default;
+		// narrow messages, and what(), are UTF-8
 		BufferedException(std::string msg);
 		BufferedException(const std::wstring& msg);
 		const char* what() const override;
@@ -17,6 +18,10 @@ namespace chil::utl
 		std::string message_;
 		mutable std::string buffer_;
 	};
+
+	// what() as a wide string: UTF-8 for BufferedException, the narrow code page for any
+	// other exception (standard library, runtime, third party)
+	std::wstring DescribeException(const std::exception& e);
 }
 
 #define ZC_EX_DEF_FROM(NewType, BaseType) class NewType : public BaseType {using Base = BaseType; public: using Base::Base;} 
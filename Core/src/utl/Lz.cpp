@@ -0,0 +1,155 @@
+#include "Lz.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace chil::utl
+{
+	namespace
+	{
+		constexpr size_t minMatch = 4;
+		constexpr size_t maxOffset = 0xFFFF;
+		constexpr int hashBits = 14;
+
+		std::uint32_t Read32(const char* p)
+		{
+			std::uint32_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+		std::uint32_t Hash(std::uint32_t v)
+		{
+			return (v * 2654435761u) >> (32 - hashBits);
+		}
+		void PutLength(std::string& out, size_t length)
+		{
+			for (; length >= 255; length -= 255) {
+				out.push_back(char(255));
+			}
+			out.push_back(char(length));
+		}
+		void PutSequence(std::string& out, std::string_view literals, size_t offset, size_t matchLength)
+		{
+			const auto extra = matchLength - minMatch;
+			out.push_back(char((std::min<size_t>(literals.size(), 15) << 4) | std::min<size_t>(extra, 15)));
+			if (literals.size() >= 15) {
+				PutLength(out, literals.size() - 15);
+			}
+			out += literals;
+			out.push_back(char(offset));
+			out.push_back(char(offset >> 8));
+			if (extra >= 15) {
+				PutLength(out, extra - 15);
+			}
+		}
+		void PutLastLiterals(std::string& out, std::string_view literals)
+		{
+			out.push_back(char(std::min<size_t>(literals.size(), 15) << 4));
+			if (literals.size() >= 15) {
+				PutLength(out, literals.size() - 15);
+			}
+			out += literals;
+		}
+		bool GetLength(std::string_view in, size_t& pos, size_t& length)
+		{
+			for (;;) {
+				if (pos >= in.size()) {
+					return false;
+				}
+				const auto b = std::uint8_t(in[pos++]);
+				length += b;
+				if (b != 255) {
+					return true;
+				}
+			}
+		}
+	}
+
+	size_t LzBound(size_t size)
+	{
+		// all literals: one token plus one length byte per 255 literals
+		return size + size / 255 + 16;
+	}
+	size_t LzCompress(std::string_view in, std::string& out)
+	{
+		const auto start = out.size();
+		out.reserve(start + LzBound(in.size()));
+		// positions are stored + 1 so that zero marks an empty entry
+		const auto table = std::make_unique<std::uint32_t[]>(size_t(1) << hashBits);
+		const auto data = in.data();
+		size_t anchor = 0;
+		size_t i = 0;
+		while (i + minMatch <= in.size()) {
+			const auto value = Read32(data + i);
+			auto& entry = table[Hash(value)];
+			const size_t candidate = entry;
+			entry = std::uint32_t(i + 1);
+			if (candidate == 0 || i - (candidate - 1) > maxOffset || Read32(data + candidate - 1) != value) {
+				// step faster through data that is not matching
+				i += 1 + ((i - anchor) >> 6);
+				continue;
+			}
+			const auto match = candidate - 1;
+			size_t length = minMatch;
+			while (i + length < in.size() && data[match + length] == data[i + length]) {
+				length++;
+			}
+			PutSequence(out, in.substr(anchor, i - anchor), i - match, length);
+			i += length;
+			anchor = i;
+		}
+		PutLastLiterals(out, in.substr(anchor));
+		return out.size() - start;
+	}
+	bool LzDecompress(std::string_view in, size_t size, std::string& out)
+	{
+		const auto start = out.size();
+		const auto end = start + size;
+		out.reserve(end);
+		size_t pos = 0;
+		for (;;) {
+			if (pos >= in.size()) {
+				return false;
+			}
+			const auto token = std::uint8_t(in[pos++]);
+			size_t literals = token >> 4;
+			if (literals == 15 && !GetLength(in, pos, literals)) {
+				return false;
+			}
+			if (literals > in.size() - pos || literals > end - out.size()) {
+				return false;
+			}
+			out.append(in.data() + pos, literals);
+			pos += literals;
+			if (pos == in.size()) {
+				return out.size() == end;
+			}
+			if (in.size() - pos < 2) {
+				return false;
+			}
+			const size_t offset = std::uint8_t(in[pos]) | (size_t(std::uint8_t(in[pos + 1])) << 8);
+			pos += 2;
+			size_t length = token & 0xF;
+			if (length == 15 && !GetLength(in, pos, length)) {
+				return false;
+			}
+			length += minMatch;
+			if (offset == 0 || offset > out.size() - start || length > end - out.size()) {
+				return false;
+			}
+			const auto to = out.size();
+			out.resize(to + length);
+			const auto p = out.data();
+			if (offset >= length) {
+				std::memcpy(p + to, p + to - offset, length);
+			}
+			else {
+				// overlapping match repeats the last offset bytes
+				for (size_t k = 0; k < length; k++) {
+					p[to + k] = p[to + k - offset];
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace chil::utl
+{
+	// LZ77 block codec in the style of LZ4: one greedy pass with a hash of 4-byte sequences
+	// and byte-aligned tokens, trading ratio for speed; suited to repetitive text such as
+	// log output
+	//
+	// a block is a series of sequences, each a token (literal count << 4 | match length - 4),
+	// counts of 15 extended by bytes that are summed while they are 255, the literals, then
+	// a 16-bit little-endian offset and extended match length; the final sequence stops
+	// after its literals
+	// largest output LzCompress can append for size input bytes
+	size_t LzBound(size_t size);
+	// appends the compressed form of in to out; returns the number of bytes appended
+	size_t LzCompress(std::string_view in, std::string& out);
+	// appends the size bytes that in decompresses to; false when in is corrupt or does not
+	// decompress to exactly size bytes, in which case out may hold a partial result
+	bool LzDecompress(std::string_view in, size_t size, std::string& out);
+}
\ No newline at end of file
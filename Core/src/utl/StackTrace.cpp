@@ -1,6 +1,9 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "StackTrace.h"
 #include <sstream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include "String.h"
 
 #pragma warning(push)
@@ -10,42 +13,82 @@
 
 namespace chil::utl
 {
+	namespace
+	{
+		// symbol handler state shared by all traces; dbghelp is initialized once here instead
+		// of on every capture, and is not thread safe, so resolution is serialized
+		class Symbols
+		{
+		public:
+			static Symbols& Get()
+			{
+				static Symbols symbols;
+				return symbols;
+			}
+			backward::ResolvedTrace Resolve(void* address, size_t idx)
+			{
+				{
+					std::shared_lock lk{ cacheMtx_ };
+					if (auto i = cache_.find(address); i != cache_.end()) {
+						return WithIndex_(i->second, idx);
+					}
+				}
+				std::lock_guard lk{ cacheMtx_ };
+				auto i = cache_.find(address);
+				if (i == cache_.end()) {
+					i = cache_.emplace(address, resolver_.resolve(backward::Trace{ address, 0 })).first;
+				}
+				return WithIndex_(i->second, idx);
+			}
+			void Print(const std::vector<backward::ResolvedTrace>& frames, std::ostream& os)
+			{
+				// printer keeps a cache of source files for snippets
+				std::lock_guard lk{ printMtx_ };
+				printer_.print(frames.begin(), frames.end(), os);
+			}
+		private:
+			static backward::ResolvedTrace WithIndex_(backward::ResolvedTrace trace, size_t idx)
+			{
+				trace.idx = idx;
+				return trace;
+			}
+			std::shared_mutex cacheMtx_;
+			std::unordered_map<void*, backward::ResolvedTrace> cache_;
+			// must be constructed before the first capture: https://github.com/bombela/backward-cpp/issues/206
+			backward::TraceResolver resolver_;
+			std::mutex printMtx_;
+			backward::Printer printer_;
+		};
+	}
+
 	StackTrace::StackTrace(size_t skip)
 	{
-		backward::TraceResolver thisIsAWorkaround; // https://github.com/bombela/backward-cpp/issues/206
-		pTrace = std::make_unique<backward::StackTrace>();
-		pTrace->load_here(64);
+		Symbols::Get();
+		backward::StackTrace trace;
+		trace.load_here(64);
 		if (skip != 0) {
-			pTrace->skip_n_firsts(skip);
+			trace.skip_n_firsts(skip);
+		}
+		if (trace.size() != 0) {
+			frames_.assign(trace.begin(), trace.begin() + trace.size());
 		}
 	}
-	StackTrace::StackTrace(const StackTrace& src)
-		:
-		pTrace{ src.pTrace ? std::make_unique<backward::StackTrace>(*src.pTrace) : std::unique_ptr<backward::StackTrace>{} }
-	{}
-	StackTrace::StackTrace(StackTrace&& donor) noexcept
-		:
-		pTrace{ std::move(donor.pTrace) }
-	{}
-	StackTrace& StackTrace::operator=(const StackTrace& src)
-	{
-		pTrace = src.pTrace ? std::make_unique<backward::StackTrace>(*src.pTrace) : std::unique_ptr<backward::StackTrace>{};
-		return *this;
-	}
-	StackTrace& StackTrace::operator=(StackTrace&& donor) noexcept
+	std::span<void* const> StackTrace::GetFrames() const
 	{
-		if (&donor != this) {
-			pTrace = std::move(donor.pTrace);
-		}
-		return *this;
+		return frames_;
 	}
-	StackTrace::~StackTrace() {}
 	std::wstring StackTrace::Print() const
 	{
-		if (pTrace) {
+		if (!frames_.empty()) {
+			auto& symbols = Symbols::Get();
+			// most recent call last
+			std::vector<backward::ResolvedTrace> resolved;
+			resolved.reserve(frames_.size());
+			for (size_t i = frames_.size(); i > 0; i--) {
+				resolved.push_back(symbols.Resolve(frames_[i - 1], i - 1));
+			}
 			std::ostringstream oss;
-			backward::Printer printer;
-			printer.print(*pTrace, oss);
+			symbols.Print(resolved, oss);
 			return utl::ToWide(oss.str());
 		}
 		else {
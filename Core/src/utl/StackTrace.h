@@ -1,26 +1,21 @@
 #pragma once
-#include <memory>
+#include <span>
 #include <string>
-
-namespace backward
-{
-	class StackTrace;
-}
+#include <vector>
 
 namespace chil::utl
 {
+	// captures only raw return addresses; symbols are resolved when the trace is printed,
+	// through a process-wide address cache so that repeated traces from the same call
+	// sites cost one lookup per frame
 	class StackTrace
 	{
 	public:
 		StackTrace(size_t skip = 0);
-		StackTrace(const StackTrace& src);
-		StackTrace(StackTrace&&) noexcept;
-		StackTrace& operator=(const StackTrace& src);
-		StackTrace& operator=(StackTrace&&) noexcept;
-		~StackTrace();
+		std::span<void* const> GetFrames() const;
 		std::wstring Print() const;
 
 	private:
-		std::unique_ptr<backward::StackTrace> pTrace;
+		std::vector<void*> frames_;
 	};
 }
\ No newline at end of file
@@ -25,4 +25,135 @@ namespace chil::utl
 		narrow.resize(actual - 1);
 		return narrow;
 	}
+
+	namespace
+	{
+		constexpr char32_t replacementChar = 0xFFFD;
+
+		void AppendCodePoint(std::string& out, char32_t cp)
+		{
+			if (cp < 0x80) {
+				out.push_back(char(cp));
+			}
+			else if (cp < 0x800) {
+				out.push_back(char(0xC0 | (cp >> 6)));
+				out.push_back(char(0x80 | (cp & 0x3F)));
+			}
+			else if (cp < 0x10000) {
+				out.push_back(char(0xE0 | (cp >> 12)));
+				out.push_back(char(0x80 | ((cp >> 6) & 0x3F)));
+				out.push_back(char(0x80 | (cp & 0x3F)));
+			}
+			else {
+				out.push_back(char(0xF0 | (cp >> 18)));
+				out.push_back(char(0x80 | ((cp >> 12) & 0x3F)));
+				out.push_back(char(0x80 | ((cp >> 6) & 0x3F)));
+				out.push_back(char(0x80 | (cp & 0x3F)));
+			}
+		}
+
+		void AppendCodePoint(std::wstring& out, char32_t cp)
+		{
+			if constexpr (sizeof(wchar_t) == 2) {
+				if (cp >= 0x10000) {
+					cp -= 0x10000;
+					out.push_back(wchar_t(0xD800 + (cp >> 10)));
+					out.push_back(wchar_t(0xDC00 + (cp & 0x3FF)));
+					return;
+				}
+			}
+			out.push_back(wchar_t(cp));
+		}
+	}
+
+	void AppendUtf8(std::string& out, std::wstring_view wide)
+	{
+		for (size_t i = 0; i < wide.size(); i++) {
+			char32_t cp = char32_t(wide[i]);
+			if constexpr (sizeof(wchar_t) == 2) {
+				if (cp >= 0xD800 && cp <= 0xDBFF) {
+					if (i + 1 < wide.size() && wide[i + 1] >= 0xDC00 && wide[i + 1] <= 0xDFFF) {
+						cp = 0x10000 + ((cp - 0xD800) << 10) + (char32_t(wide[i + 1]) - 0xDC00);
+						i++;
+					}
+					else {
+						cp = replacementChar;
+					}
+				}
+				else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+					cp = replacementChar;
+				}
+			}
+			else if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+				cp = replacementChar;
+			}
+			AppendCodePoint(out, cp);
+		}
+	}
+
+	std::string ToUtf8(std::wstring_view wide)
+	{
+		std::string utf8;
+		utf8.reserve(wide.size());
+		AppendUtf8(utf8, wide);
+		return utf8;
+	}
+
+	void AppendWide(std::wstring& out, std::string_view utf8)
+	{
+		size_t i = 0;
+		while (i < utf8.size()) {
+			const auto lead = (unsigned char)utf8[i];
+			int length = 0;
+			char32_t cp = 0;
+			if (lead < 0x80) {
+				length = 1;
+				cp = lead;
+			}
+			else if ((lead & 0xE0) == 0xC0) {
+				length = 2;
+				cp = lead & 0x1F;
+			}
+			else if ((lead & 0xF0) == 0xE0) {
+				length = 3;
+				cp = lead & 0x0F;
+			}
+			else if ((lead & 0xF8) == 0xF0) {
+				length = 4;
+				cp = lead & 0x07;
+			}
+			else {
+				AppendCodePoint(out, replacementChar);
+				i++;
+				continue;
+			}
+			if (i + length > utf8.size()) {
+				AppendCodePoint(out, replacementChar);
+				break;
+			}
+			bool valid = true;
+			for (int n = 1; n < length; n++) {
+				const auto trail = (unsigned char)utf8[i + n];
+				if ((trail & 0xC0) != 0x80) {
+					valid = false;
+					length = n;
+					break;
+				}
+				cp = (cp << 6) | (trail & 0x3F);
+			}
+			if (!valid || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+				cp = replacementChar;
+			}
+			AppendCodePoint(out, cp);
+			i += length;
+		}
+	}
+
+	std::wstring FromUtf8(std::string_view utf8)
+	{
+		std::wstring wide;
+		wide.reserve(utf8.size());
+		AppendWide(wide, utf8);
+		return wide;
+	}
 }
\ No newline at end of file
@@ -1,8 +1,25 @@
 #pragma once
 #include <string>
+#include <string_view>
 
 namespace chil::utl
 {
 	std::wstring ToWide(const std::string& narrow);
 	std::string ToNarrow(const std::wstring& wide);
+	// locale-independent UTF-8 conversions (wide strings are UTF-16 or UTF-32 depending on
+	// the width of wchar_t); invalid sequences are replaced with U+FFFD
+	void AppendUtf8(std::string& out, std::wstring_view wide);
+	std::string ToUtf8(std::wstring_view wide);
+	void AppendWide(std::wstring& out, std::string_view utf8);
+	std::wstring FromUtf8(std::string_view utf8);
+	// UTF-8 text is typed as char8_t at interfaces and handed to byte-oriented APIs
+	// (streams, std::format, char-based OS calls) as char without any conversion
+	inline std::string_view AsChars(std::u8string_view utf8)
+	{
+		return { reinterpret_cast<const char*>(utf8.data()), utf8.size() };
+	}
+	inline std::u8string_view AsUtf8(std::string_view bytes)
+	{
+		return { reinterpret_cast<const char8_t*>(bytes.data()), bytes.size() };
+	}
 }
\ No newline at end of file
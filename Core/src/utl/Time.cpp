@@ -0,0 +1,68 @@
+#include "Time.h"
+#include <charconv>
+
+namespace chil::utl
+{
+	namespace
+	{
+		bool ParseField(std::string_view text, size_t& pos, size_t digits, int& value)
+		{
+			if (text.size() - pos < digits) {
+				return false;
+			}
+			const auto first = text.data() + pos;
+			const auto [end, ec] = std::from_chars(first, first + digits, value);
+			if (ec != std::errc{} || end != first + digits) {
+				return false;
+			}
+			pos += digits;
+			return true;
+		}
+		bool Expect(std::string_view text, size_t& pos, std::string_view separators)
+		{
+			if (pos >= text.size() || separators.find(text[pos]) == separators.npos) {
+				return false;
+			}
+			pos++;
+			return true;
+		}
+	}
+
+	std::optional<LocalTime> ParseLocalTime(std::string_view text, size_t* pConsumed)
+	{
+		using namespace std::chrono;
+		size_t pos = 0;
+		int y, mo, d, h, mi, s;
+		if (!ParseField(text, pos, 4, y) || !Expect(text, pos, "-") ||
+			!ParseField(text, pos, 2, mo) || !Expect(text, pos, "-") ||
+			!ParseField(text, pos, 2, d) || !Expect(text, pos, " T") ||
+			!ParseField(text, pos, 2, h) || !Expect(text, pos, ":") ||
+			!ParseField(text, pos, 2, mi) || !Expect(text, pos, ":") ||
+			!ParseField(text, pos, 2, s)) {
+			return std::nullopt;
+		}
+		const year_month_day date{ year{ y }, month{ unsigned(mo) }, day{ unsigned(d) } };
+		if (!date.ok() || h > 23 || mi > 59 || s > 60) {
+			return std::nullopt;
+		}
+		auto time = LocalTime{ local_days{ date } + hours{ h } + minutes{ mi } + seconds{ s } };
+		if (pos < text.size() && text[pos] == '.') {
+			pos++;
+			// digits beyond the clock's resolution are dropped
+			auto scale = system_clock::duration{ seconds{ 1 } }.count();
+			while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+				scale /= 10;
+				time += system_clock::duration{ (text[pos] - '0') * scale };
+				pos++;
+			}
+		}
+		if (pConsumed) {
+			*pConsumed = pos;
+		}
+		return time;
+	}
+	std::chrono::system_clock::time_point ToSystemTime(LocalTime time)
+	{
+		return std::chrono::current_zone()->to_sys(time, std::chrono::choose::earliest);
+	}
+}
\ No newline at end of file
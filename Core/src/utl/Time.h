@@ -0,0 +1,16 @@
+#pragma once
+#include <chrono>
+#include <optional>
+#include <string_view>
+
+namespace chil::utl
+{
+	using LocalTime = std::chrono::local_time<std::chrono::system_clock::duration>;
+
+	// parses a wall-clock time in the layout TextFormatter prints, "YYYY-MM-DD HH:MM:SS"
+	// with optional fractional seconds ('T' is also accepted as the separator); anything
+	// after the seconds is ignored; consumed is set to the number of characters parsed
+	std::optional<LocalTime> ParseLocalTime(std::string_view text, size_t* pConsumed = nullptr);
+	// converts a wall-clock time in this machine's zone to a system time
+	std::chrono::system_clock::time_point ToSystemTime(LocalTime time);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "MappedFile.h"
+#include "ChilWin.h"
+
+namespace chil::win
+{
+	MappedFile::MappedFile(std::filesystem::path path)
+	{
+		const auto hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (hFile != INVALID_HANDLE_VALUE) {
+			hFile_ = hFile;
+			Remap();
+		}
+	}
+	MappedFile::~MappedFile()
+	{
+		Unmap_();
+		if (hFile_) {
+			CloseHandle(hFile_);
+		}
+	}
+	bool MappedFile::IsOpen() const
+	{
+		return hFile_ != nullptr;
+	}
+	bool MappedFile::Remap()
+	{
+		if (!hFile_) {
+			return false;
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(hFile_, &size)) {
+			return false;
+		}
+		if (pView_ && size_t(size.QuadPart) == size_) {
+			return true;
+		}
+		Unmap_();
+		// a zero-length file cannot be mapped, but it is simply empty
+		if (size.QuadPart == 0) {
+			return true;
+		}
+		hMapping_ = CreateFileMappingW(hFile_, nullptr, PAGE_READONLY, size.HighPart, size.LowPart, nullptr);
+		if (!hMapping_) {
+			return false;
+		}
+		pView_ = static_cast<const char*>(MapViewOfFile(hMapping_, FILE_MAP_READ, 0, 0, size_t(size.QuadPart)));
+		if (!pView_) {
+			Unmap_();
+			return false;
+		}
+		size_ = size_t(size.QuadPart);
+		return true;
+	}
+	std::string_view MappedFile::GetData() const
+	{
+		return { pView_, size_ };
+	}
+	void MappedFile::Unmap_()
+	{
+		if (pView_) {
+			UnmapViewOfFile(pView_);
+			pView_ = nullptr;
+		}
+		if (hMapping_) {
+			CloseHandle(hMapping_);
+			hMapping_ = nullptr;
+		}
+		size_ = 0;
+	}
+}
\ No newline at end of file
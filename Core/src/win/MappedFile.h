@@ -0,0 +1,32 @@
+#pragma once
+#include <filesystem>
+#include <string_view>
+
+namespace chil::win
+{
+	// read-only view of a whole file; the file stays open for writing by others (a log
+	// driver appending to it), and Remap picks up whatever has been appended since
+	class MappedFile
+	{
+	public:
+		MappedFile(std::filesystem::path path);
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		// false when the file could not be opened
+		bool IsOpen() const;
+		// maps the file at its current size; false when the mapping failed
+		bool Remap();
+		// contents as of the last Remap (empty for an empty or unopened file)
+		std::string_view GetData() const;
+	private:
+		// functions
+		void Unmap_();
+		// data
+		// HANDLEs, kept opaque so that the header does not pull in Windows.h
+		void* hFile_ = nullptr;
+		void* hMapping_ = nullptr;
+		const char* pView_ = nullptr;
+		size_t size_ = 0;
+	};
+}
\ No newline at end of file
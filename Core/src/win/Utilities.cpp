@@ -59,4 +59,22 @@ namespace chil::win
 		}
 		return ToSpaRect(rect).GetDimensions();
 	}
+
+	std::filesystem::path GetExecutableDirectory()
+	{
+		std::wstring path(MAX_PATH, L'\0');
+		while (true) {
+			const auto length = GetModuleFileNameW(nullptr, path.data(), DWORD(path.size()));
+			if (length == 0) {
+				chilog.error(L"Failed to get executable path").hr();
+				throw WindowException{ "Failed to get executable path" };
+			}
+			// a full buffer means the path was truncated
+			if (length < path.size()) {
+				path.resize(length);
+				return std::filesystem::path{ path }.parent_path();
+			}
+			path.resize(path.size() * 2);
+		}
+	}
 }
\ No newline at end of file
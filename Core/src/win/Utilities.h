@@ -1,5 +1,6 @@
 #pragma once 
 #include <string> 
+#include <filesystem> 
 #include "ChilWin.h" 
 #include <Core/src/spa/Dimensions.h> 
 #include <Core/src/spa/Rect.h> 
@@ -10,4 +11,6 @@ namespace chil::win
 	RECT ToWinRect(const spa::RectI&);
 	spa::RectI ToSpaRect(const RECT&);
 	spa::DimensionsI ClientToWindowDimensions(const spa::DimensionsI& dims, DWORD styles);
+	// directory of the running executable, independent of the working directory
+	std::filesystem::path GetExecutableDirectory();
 }
\ No newline at end of file
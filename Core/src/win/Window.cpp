@@ -78,15 +78,15 @@ namespace chil::win
 				closing_ = true;
 				return 0;
 			case CustomTaskMessageId:
-				tasks_.PopExecute();
+				// cleared before draining: a dispatch that finds it cleared posts again, and
+				// its task is either in this drain or picked up by that next message
+				taskNotifyPending_ = false;
+				tasks_.DrainExecute();
 				return 0;
 			}
 		}
 		catch (const std::exception& e) {
-			chilog.error(std::format(
-				L"Uncaught exception in Windows message handler: {}",
-				utl::ToWide(e.what())
-			));
+			chilog.error(L"Uncaught exception in Windows message handler: " + utl::DescribeException(e));
 		}
 		catch (...) {
 			chilog.error(L"Uncaught annonymous exception in Windows message handler");
@@ -96,6 +96,7 @@ namespace chil::win
 	void Window::NotifyTaskDispatch_() const
 	{
 		if (!PostMessageW(hWnd_, CustomTaskMessageId, 0, 0)) {
+			taskNotifyPending_ = false;
 			chilog.error().hr();
 			throw WindowException{ "Failed to post task notification message" };
 		}
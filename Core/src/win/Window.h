@@ -31,7 +31,11 @@ namespace chil::win
 		auto Dispatch_(F&& f) const
 		{
 			auto future = tasks_.Push(std::forward<F>(f));
-			NotifyTaskDispatch_();
+			// one message drains every task queued before it is handled, so a burst of
+			// dispatches posts a single message
+			if (!taskNotifyPending_.exchange(true)) {
+				NotifyTaskDispatch_();
+			}
 			return future;
 		}
 		void NotifyTaskDispatch_() const;
@@ -42,5 +46,6 @@ namespace chil::win
 		std::thread kernelThread_;
 		HWND hWnd_ = nullptr;
 		std::atomic<bool> closing_ = false;
+		mutable std::atomic<bool> taskNotifyPending_ = false;
 	};
 }
\ No newline at end of file
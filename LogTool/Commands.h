@@ -0,0 +1,13 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace chil::tool
+{
+	// each command receives the arguments following its name and returns the exit code
+	int Decode(const std::vector<std::string>& args);
+	int Flight(const std::vector<std::string>& args);
+	int Index(const std::vector<std::string>& args);
+	int Query(const std::vector<std::string>& args);
+	int Unpack(const std::vector<std::string>& args);
+}
\ No newline at end of file
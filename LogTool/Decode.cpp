@@ -0,0 +1,23 @@
+#include "Commands.h"
+#include "TextOutput.h"
+#include <Core/src/log/BinaryFileReader.h>
+#include <iostream>
+
+namespace chil::tool
+{
+	int Decode(const std::vector<std::string>& args)
+	{
+		if (args.empty()) {
+			std::cerr << "usage: LogTool decode <in.bin> [out.txt]\n";
+			return 1;
+		}
+		log::BinaryFileReader reader{ args[0] };
+		TextOutput out{ args.size() > 1 ? args[1] : std::string{} };
+		log::Entry e;
+		while (reader.Next(e)) {
+			out.Write(e);
+		}
+		std::cerr << out.GetCount() << " entries decoded\n";
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "Commands.h"
+#include "TextOutput.h"
+#include <Core/src/log/FlightRecorderReader.h>
+#include <iostream>
+
+namespace chil::tool
+{
+	int Flight(const std::vector<std::string>& args)
+	{
+		if (args.empty()) {
+			std::cerr << "usage: LogTool flight <ring.bin> [out.txt]\n";
+			return 1;
+		}
+		log::FlightRecorderReader reader{ args[0] };
+		if (!reader.IsValid()) {
+			std::cerr << "error: " << args[0] << " is not a flight recorder file\n";
+			return 1;
+		}
+		TextOutput out{ args.size() > 1 ? args[1] : std::string{} };
+		log::Entry e;
+		while (reader.Next(e)) {
+			out.Write(e);
+		}
+		std::cerr << out.GetCount() << " entries recovered";
+		if (const auto discarded = reader.GetDiscardedCount()) {
+			std::cerr << ", " << discarded << " torn slots discarded";
+		}
+		std::cerr << "\n";
+		return 0;
+	}
+}
\ No newline at end of file
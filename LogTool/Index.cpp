@@ -0,0 +1,31 @@
+#include "Commands.h"
+#include <Core/src/log/TextLogIndex.h>
+#include <iostream>
+
+namespace chil::tool
+{
+	int Index(const std::vector<std::string>& args)
+	{
+		if (args.empty()) {
+			std::cerr << "usage: LogTool index <log.txt>\n";
+			return 1;
+		}
+		log::TextLogIndex index{ args[0] };
+		if (!index.IsValid()) {
+			std::cerr << "error: cannot open " << args[0] << "\n";
+			return 1;
+		}
+		const auto before = index.GetPersistedCount();
+		if (!index.Update()) {
+			std::cerr << "error: cannot write " << log::TextLogIndex::GetIndexPath(args[0]).string() << "\n";
+			return 1;
+		}
+		std::cerr << index.GetRecords().size() << " entries indexed";
+		// a shrinking count means the log was replaced and the index rebuilt
+		if (index.GetPersistedCount() >= before) {
+			std::cerr << " (" << index.GetPersistedCount() - before << " new)";
+		}
+		std::cerr << "\n";
+		return 0;
+	}
+}
\ No newline at end of file
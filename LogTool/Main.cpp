@@ -0,0 +1,55 @@
+#include "Commands.h"
+#include <Core/src/ioc/Container.h>
+#include <Core/src/ioc/Singletons.h>
+#include <Core/src/log/Channel.h>
+#include <iostream>
+#include <functional>
+#include <map>
+
+using namespace chil;
+
+namespace
+{
+	const std::map<std::string, std::function<int(const std::vector<std::string>&)>> commands{
+		{ "decode", tool::Decode },
+		{ "flight", tool::Flight },
+		{ "index", tool::Index },
+		{ "query", tool::Query },
+		{ "unpack", tool::Unpack },
+	};
+
+	void Boot()
+	{
+		// the tool itself logs nowhere; this only satisfies code paths that report through chilog
+		ioc::Get().Register<log::IChannel>([] {
+			return std::make_shared<log::Channel>();
+		});
+		ioc::Sing().RegisterPassthru<log::IChannel>();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2 || !commands.contains(argv[1])) {
+		std::cerr << "usage: LogTool <command> [args...]\n"
+			"  decode <in.bin> [out.txt]   convert a BinaryFileDriver log to text\n"
+			"  flight <ring.bin> [out.txt] extract a FlightRecorderDriver ring, oldest first\n"
+			"  index <log.txt>             build or update the sidecar index of a text log\n"
+			"  query <log.txt> [out.txt] [--from <time>] [--to <time>] [--level <level>]\n"
+			"        [--file <name>] [--line <n>]\n"
+			"                              print the entries of a text log matching a local time\n"
+			"                              range, a level and more severe, and a source file/line\n"
+			"  unpack <in.lz> [out.txt] [--from <time>] [--to <time>]\n"
+			"                              decompress a CompressedFileDriver log, optionally only\n"
+			"                              the blocks covering a local time range\n";
+		return 1;
+	}
+	try {
+		Boot();
+		return commands.at(argv[1])({ argv + 2, argv + argc });
+	}
+	catch (const std::exception& e) {
+		std::cerr << "error: " << e.what() << "\n";
+	}
+	return -1;
+}
\ No newline at end of file
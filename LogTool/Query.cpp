@@ -0,0 +1,87 @@
+#include "Commands.h"
+#include <Core/src/log/TextLogIndex.h>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <optional>
+
+namespace chil::tool
+{
+	int Query(const std::vector<std::string>& args)
+	{
+		// positional arguments are the log and optional output, options take a value
+		std::vector<std::string> paths;
+		log::TextLogIndex::Query query;
+		for (size_t i = 0; i < args.size(); i++) {
+			const auto& option = args[i];
+			if (!option.starts_with("--")) {
+				paths.push_back(option);
+				continue;
+			}
+			if (i + 1 >= args.size()) {
+				std::cerr << "error: " << option << " needs a value\n";
+				return 1;
+			}
+			const auto& value = args[++i];
+			if (option == "--from" || option == "--to") {
+				const auto time = utl::ParseLocalTime(value);
+				if (!time) {
+					std::cerr << "error: bad time '" << value << "', expected YYYY-MM-DD HH:MM:SS\n";
+					return 1;
+				}
+				(option == "--from" ? query.from : query.to) = *time;
+			}
+			else if (option == "--level") {
+				// level names are ASCII, so widening byte by byte is enough
+				const auto level = log::ParseLevelName(std::wstring{ value.begin(), value.end() });
+				if (!level) {
+					std::cerr << "error: bad level '" << value << "', expected a level name (Error, Warning, ...)\n";
+					return 1;
+				}
+				query.level = *level;
+			}
+			else if (option == "--file") {
+				query.file = value;
+			}
+			else if (option == "--line") {
+				const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), query.line);
+				if (ec != std::errc{} || end != value.data() + value.size()) {
+					std::cerr << "error: bad line '" << value << "'\n";
+					return 1;
+				}
+			}
+			else {
+				std::cerr << "error: unknown option " << option << "\n";
+				return 1;
+			}
+		}
+		if (paths.empty()) {
+			std::cerr << "usage: LogTool query <log.txt> [out.txt] [--from <time>] [--to <time>]\n"
+				"                      [--level <level>] [--file <name>] [--line <n>]\n";
+			return 1;
+		}
+		log::TextLogIndex index{ paths[0] };
+		if (!index.IsValid()) {
+			std::cerr << "error: cannot open " << paths[0] << "\n";
+			return 1;
+		}
+		// picks up anything appended since the index was last brought up to date; a
+		// read-only location only costs the rescan
+		if (!index.Update()) {
+			std::cerr << "warning: cannot write " << log::TextLogIndex::GetIndexPath(paths[0]).string() << "\n";
+		}
+		std::ofstream file;
+		std::ostream* pOut = &std::cout;
+		if (paths.size() > 1) {
+			file.open(paths[1], std::ios::out | std::ios::binary);
+			pOut = &file;
+		}
+		const auto matches = index.Find(query);
+		for (const auto i : matches) {
+			const auto text = index.GetText(index.GetRecords()[i]);
+			pOut->write(text.data(), std::streamsize(text.size()));
+		}
+		std::cerr << matches.size() << " of " << index.GetRecords().size() << " entries matched\n";
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "TextOutput.h"
+#include <iostream>
+
+namespace chil::tool
+{
+	TextOutput::TextOutput(const std::string& path)
+		:
+		pOut_{ &std::cout }
+	{
+		if (!path.empty()) {
+			file_.open(path, std::ios::out | std::ios::binary);
+			pOut_ = &file_;
+		}
+	}
+	void TextOutput::Write(const log::Entry& e)
+	{
+		text_.clear();
+		formatter_.FormatUtf8To(text_, e);
+		pOut_->write(text_.data(), text_.size());
+		count_++;
+	}
+	size_t TextOutput::GetCount() const
+	{
+		return count_;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+#include <Core/src/log/Entry.h>
+#include <Core/src/log/TextFormatter.h>
+#include <fstream>
+#include <string>
+
+namespace chil::tool
+{
+	// renders entries as UTF-8 text to a file, or to stdout when no path is given
+	class TextOutput
+	{
+	public:
+		TextOutput(const std::string& path = {});
+		void Write(const log::Entry& e);
+		size_t GetCount() const;
+	private:
+		std::ofstream file_;
+		std::ostream* pOut_;
+		log::TextFormatter formatter_;
+		std::string text_;
+		size_t count_ = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "Commands.h"
+#include <Core/src/log/CompressedFileReader.h>
+#include <Core/src/utl/Time.h>
+#include <fstream>
+#include <iostream>
+
+namespace chil::tool
+{
+	int Unpack(const std::vector<std::string>& args)
+	{
+		// positional arguments are the input and optional output, options take a value
+		std::vector<std::string> paths;
+		auto from = std::chrono::system_clock::time_point::min();
+		auto to = std::chrono::system_clock::time_point::max();
+		for (size_t i = 0; i < args.size(); i++) {
+			if ((args[i] == "--from" || args[i] == "--to") && i + 1 < args.size()) {
+				const auto time = utl::ParseLocalTime(args[i + 1]);
+				if (!time) {
+					std::cerr << "error: bad time '" << args[i + 1] << "', expected YYYY-MM-DD HH:MM:SS\n";
+					return 1;
+				}
+				(args[i] == "--from" ? from : to) = utl::ToSystemTime(*time);
+				i++;
+			}
+			else {
+				paths.push_back(args[i]);
+			}
+		}
+		if (paths.empty()) {
+			std::cerr << "usage: LogTool unpack <in.lz> [out.txt] [--from <time>] [--to <time>]\n";
+			return 1;
+		}
+		log::CompressedFileReader reader{ paths[0] };
+		if (!reader.IsValid()) {
+			std::cerr << "error: " << paths[0] << " is not a compressed log file\n";
+			return 1;
+		}
+		std::ofstream file;
+		std::ostream* pOut = &std::cout;
+		if (paths.size() > 1) {
+			file.open(paths[1], std::ios::out | std::ios::binary);
+			pOut = &file;
+		}
+		// only blocks overlapping the range are decompressed; the range is applied at block
+		// granularity, so edge blocks can contribute entries just outside it
+		const auto blocks = reader.FindBlocks(from, to);
+		std::string text;
+		size_t corrupt = 0;
+		for (const auto index : blocks) {
+			text.clear();
+			if (!reader.ReadBlock(index, text)) {
+				corrupt++;
+				continue;
+			}
+			pOut->write(text.data(), std::streamsize(text.size()));
+		}
+		std::cerr << blocks.size() - corrupt << " of " << reader.GetBlocks().size() << " blocks unpacked";
+		if (corrupt) {
+			std::cerr << ", " << corrupt << " corrupt blocks skipped";
+		}
+		std::cerr << "\n";
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/ccr/BoundedTaskQueue.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace ccr;
+
+namespace Ccr
+{
+	TEST_CLASS(CcrBoundedTaskQueue)
+	{
+	public:
+		// tasks run in push order and their results reach the futures
+		TEST_METHOD(PushAndPopExecute)
+		{
+			BoundedTaskQueue taskQueue{ 4 };
+			int x = 0;
+			auto future1 = taskQueue.Push([&x]() { return x += 1; });
+			auto future2 = taskQueue.Push([&x]() { return x += 2; });
+			taskQueue.PopExecute();
+			taskQueue.PopExecute();
+			Assert::AreEqual(1, future1.get());
+			Assert::AreEqual(3, future2.get());
+			Assert::AreEqual(3, x);
+		}
+		// producers wait for room when the ring is full, and consumers for tasks when empty
+		TEST_METHOD(MultipleThreadsPushAndPopExecute)
+		{
+			BoundedTaskQueue taskQueue{ 8 };
+			std::atomic<int> x{ 0 };
+			{
+				std::vector<std::jthread> threads;
+				for (int i = 0; i < 4; i++) {
+					threads.emplace_back([&] {
+						for (int j = 0; j < 1000; j++) {
+							taskQueue.Push([&x] { x++; });
+						}
+					});
+					threads.emplace_back([&] {
+						for (int j = 0; j < 1000; j++) {
+							taskQueue.PopExecute();
+						}
+					});
+				}
+			}
+			Assert::AreEqual(4000, x.load());
+		}
+		// a consumer that finds the queue empty parks until a push wakes it
+		TEST_METHOD(PopParksUntilPush)
+		{
+			BoundedTaskQueue taskQueue{ 8 };
+			std::atomic<int> x{ 0 };
+			std::jthread consumer{ [&] {
+				taskQueue.PopExecute();
+				taskQueue.PopExecute();
+			} };
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+			Assert::AreEqual(0, x.load());
+			taskQueue.Push([&x] { x++; });
+			taskQueue.Push([&x] { x++; });
+			consumer.join();
+			Assert::AreEqual(2, x.load());
+		}
+		// a producer that finds the queue full parks until a pop makes room
+		TEST_METHOD(PushParksUntilPop)
+		{
+			BoundedTaskQueue taskQueue{ 2 };
+			std::atomic<int> x{ 0 };
+			std::atomic<bool> pushed{ false };
+			std::jthread producer{ [&] {
+				for (int i = 0; i < 4; i++) {
+					taskQueue.Push([&x] { x++; });
+				}
+				pushed = true;
+			} };
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+			Assert::IsFalse(pushed.load());
+			for (int i = 0; i < 4; i++) {
+				taskQueue.PopExecute();
+			}
+			producer.join();
+			Assert::IsTrue(pushed.load());
+			Assert::AreEqual(4, x.load());
+		}
+	};
+}
\ No newline at end of file
@@ -1,12 +1,15 @@
 #include "ChilCppUnitTest.h"
 #include <Core/src/ccr/GenericTaskQueue.h>
 #include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 using namespace chil;
 using namespace ccr;
 using namespace std::string_literals;
+using namespace std::chrono_literals;
 
 namespace Ccr
 {
@@ -72,5 +75,61 @@ namespace Ccr
 			// Check result of x
 			Assert::AreEqual(10, x.load());
 		}
+		// the non-blocking and timed pops report an empty queue instead of waiting on it
+		TEST_METHOD(TryAndWaitPopExecute)
+		{
+			GenericTaskQueue taskQueue;
+			Assert::IsFalse(taskQueue.TryPopExecute());
+			Assert::IsFalse(taskQueue.WaitPopExecute(10ms));
+
+			int x = 0;
+			taskQueue.Push([&x] { x++; });
+			Assert::IsTrue(taskQueue.TryPopExecute());
+			Assert::IsFalse(taskQueue.TryPopExecute());
+
+			// a push from another thread wakes the waiting pop
+			std::jthread pusher{ [&] {
+				std::this_thread::sleep_for(10ms);
+				taskQueue.Push([&x] { x++; });
+			} };
+			Assert::IsTrue(taskQueue.WaitPopExecute(10s));
+			Assert::AreEqual(2, x);
+		}
+		// detached tasks need no future, and exceptions of pushed tasks come back through theirs
+		TEST_METHOD(PushDetachedAndExceptions)
+		{
+			GenericTaskQueue taskQueue;
+			int x = 0;
+			taskQueue.PushDetached([&x] { x = 1; });
+			auto future = taskQueue.Push([]() -> int { throw std::runtime_error{ "boom" }; });
+			Assert::AreEqual(size_t(2), taskQueue.DrainExecute());
+			Assert::AreEqual(1, x);
+			Assert::ExpectException<std::runtime_error>([&] { future.get(); });
+		}
+		// callables returning a reference get a future of that reference
+		TEST_METHOD(PushReturningReference)
+		{
+			GenericTaskQueue taskQueue;
+			int x = 0;
+			auto future = taskQueue.Push([&x]() -> int& { return x; });
+			taskQueue.PopExecute();
+			Assert::IsTrue(&future.get() == &x);
+		}
+		// a drain runs up to max tasks in push order and leaves the rest queued
+		TEST_METHOD(DrainExecute)
+		{
+			GenericTaskQueue taskQueue;
+			std::vector<int> order;
+			for (int i = 0; i < 10; i++) {
+				taskQueue.Push([&order, i] { order.push_back(i); });
+			}
+			Assert::AreEqual(size_t(4), taskQueue.DrainExecute(4));
+			Assert::AreEqual(size_t(6), taskQueue.DrainExecute());
+			Assert::AreEqual(size_t(0), taskQueue.DrainExecute());
+			Assert::AreEqual(size_t(10), order.size());
+			for (int i = 0; i < 10; i++) {
+				Assert::AreEqual(i, order[i]);
+			}
+		}
 	};
 }
\ No newline at end of file
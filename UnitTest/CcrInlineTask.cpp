@@ -0,0 +1,47 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/ccr/InlineTask.h>
+#include <array>
+#include <memory>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace ccr;
+
+namespace Ccr
+{
+	TEST_CLASS(CcrInlineTask)
+	{
+	public:
+		// small captures and large ones (heap fallback) both survive moves and run once
+		TEST_METHOD(MoveAndInvoke)
+		{
+			int x = 0;
+			InlineTask<> small{ [&x] { x += 1; } };
+			std::array<int, 64> big{};
+			big[63] = 10;
+			InlineTask<> large{ [&x, big] { x += big[63]; } };
+			InlineTask<> moved{ std::move(small) };
+			Assert::IsFalse(bool(small));
+			moved();
+			large = std::move(moved);
+			large();
+			Assert::AreEqual(2, x);
+		}
+		// captured state is destroyed exactly once, whether the task ran, moved or neither
+		TEST_METHOD(DestroysCapture)
+		{
+			auto pShared = std::make_shared<int>(0);
+			{
+				InlineTask<> a{ [pShared] {} };
+				Assert::AreEqual(2l, pShared.use_count());
+				InlineTask<> b{ std::move(a) };
+				Assert::AreEqual(2l, pShared.use_count());
+				b = InlineTask<>{ [] {} };
+				Assert::AreEqual(1l, pShared.use_count());
+				b = InlineTask<>{ [pShared, pad = std::array<char, 128>{}] {} };
+			}
+			Assert::AreEqual(1l, pShared.use_count());
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/ccr/PoolAllocator.h>
+#include <cstddef>
+#include <future>
+#include <semaphore>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace ccr;
+
+namespace Ccr
+{
+	TEST_CLASS(CcrPoolAllocator)
+	{
+	public:
+		// a freed block is handed out again by the next allocation of its size
+		TEST_METHOD(ReusesBlocks)
+		{
+			PoolAllocator<double> alloc;
+			const auto p1 = alloc.allocate(1);
+			alloc.deallocate(p1, 1);
+			const auto p2 = alloc.allocate(1);
+			Assert::IsTrue(p1 == p2);
+			alloc.deallocate(p2, 1);
+		}
+		// promise states allocated on one thread and released on another: the setter keeps
+		// its promise until the future has let go of the state, so the setter frees it
+		TEST_METHOD(PromiseAcrossThreads)
+		{
+			for (int i = 0; i < 1000; i++) {
+				std::promise<int> promise{ std::allocator_arg, PoolAllocator<std::byte>{} };
+				auto future = promise.get_future();
+				std::binary_semaphore released{ 0 };
+				std::jthread setter{ [&released, promise = std::move(promise), i]() mutable {
+					promise.set_value(i);
+					released.acquire();
+					auto last = std::move(promise);
+				} };
+				Assert::AreEqual(i, future.get());
+				Assert::IsFalse(future.valid());
+				released.release();
+			}
+		}
+	};
+}
\ No newline at end of file
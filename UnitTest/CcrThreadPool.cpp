@@ -0,0 +1,67 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/ccr/ThreadPool.h>
+#include <atomic>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace ccr;
+
+namespace Ccr
+{
+	TEST_CLASS(CcrThreadPool)
+	{
+	public:
+		// results and exceptions come back through the future
+		TEST_METHOD(PushFuture)
+		{
+			ThreadPool pool{ 4 };
+			auto future1 = pool.Push([] { return 42; });
+			auto future2 = pool.Push([]() -> int { throw std::runtime_error{ "boom" }; });
+			Assert::AreEqual(42, future1.get());
+			Assert::ExpectException<std::runtime_error>([&] { future2.get(); });
+		}
+		// detached tasks still queued when the pool is destroyed are run first
+		TEST_METHOD(DetachedDrainOnDestruction)
+		{
+			std::atomic<int> x{ 0 };
+			{
+				ThreadPool pool{ 2 };
+				for (int i = 0; i < 10'000; i++) {
+					pool.PushDetached([&x] { x++; });
+				}
+			}
+			Assert::AreEqual(10'000, x.load());
+		}
+		// futures of a bulk push line up with the functions
+		TEST_METHOD(PushBulk)
+		{
+			ThreadPool pool{ 4 };
+			std::vector<std::function<int()>> functions;
+			for (int i = 0; i < 100; i++) {
+				functions.push_back([i] { return i * 2; });
+			}
+			auto futures = pool.PushBulk(functions);
+			Assert::AreEqual(size_t(100), futures.size());
+			for (int i = 0; i < 100; i++) {
+				Assert::AreEqual(i * 2, futures[i].get());
+			}
+		}
+		// tasks pushed from a worker go to its own deque and get stolen by the others
+		TEST_METHOD(NestedPush)
+		{
+			ThreadPool pool{ 4 };
+			std::atomic<int> x{ 0 };
+			pool.Push([&] {
+				std::vector<std::future<void>> inner;
+				for (int i = 0; i < 1000; i++) {
+					inner.push_back(pool.Push([&x] { x++; }));
+				}
+				for (auto& future : inner) {
+					future.get();
+				}
+			}).get();
+			Assert::AreEqual(1000, x.load());
+		}
+	};
+}
\ No newline at end of file
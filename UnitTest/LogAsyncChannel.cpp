@@ -0,0 +1,136 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/AsyncChannel.h>
+#include <Core/src/log/Driver.h>
+#include <Core/src/log/SeverityLevelPolicy.h>
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::string_literals;
+
+#define chilog log::EntryBuilder{ __FILEW__, __FUNCTIONW__, __LINE__ }
+
+class CountingDriver : public log::IDriver
+{
+public:
+	void Submit(const log::Entry& e) override
+	{
+		entry_ = e;
+		submitCount_++;
+	}
+	void Flush() override
+	{
+		flushCount_++;
+	}
+	log::Entry entry_;
+	std::atomic<int> submitCount_ = 0;
+	std::atomic<int> flushCount_ = 0;
+};
+
+namespace
+{
+	// holds up the channel thread until opened, so that producers fill the ring
+	class GatedDriver : public log::IDriver
+	{
+	public:
+		void Submit(const log::Entry&) override
+		{
+			open_.wait(false);
+			submitCount_++;
+		}
+		void Flush() override {}
+		void Open()
+		{
+			open_.store(true);
+			open_.notify_all();
+		}
+		std::atomic<bool> open_ = false;
+		std::atomic<int> submitCount_ = 0;
+	};
+}
+
+template<> inline std::wstring __cdecl
+Microsoft::VisualStudio::CppUnitTestFramework::
+ToString<log::Level>(const log::Level& level)
+{
+	return log::GetLevelName(level);
+}
+
+namespace Log
+{
+	TEST_CLASS(LogAsyncChannelTests)
+	{
+	public:
+		// entries reach the driver once the channel is flushed
+		TEST_METHOD(TestForwardingAfterFlush)
+		{
+			auto pDriver = std::make_shared<CountingDriver>();
+			log::AsyncChannel chan{ { pDriver } };
+			chilog.info(L"HI").chan(&chan);
+			chan.Flush();
+			Assert::AreEqual(L"HI"s, pDriver->entry_.note_);
+			Assert::AreEqual(log::Level::Info, pDriver->entry_.level_);
+			Assert::AreEqual(1, pDriver->submitCount_.load());
+			Assert::AreEqual(1, pDriver->flushCount_.load());
+		}
+		// policies are applied on the channel thread
+		TEST_METHOD(TestPolicyFiltering)
+		{
+			auto pDriver = std::make_shared<CountingDriver>();
+			log::AsyncChannel chan{ { pDriver } };
+			chan.AttachPolicy(std::make_shared<log::SeverityLevelPolicy>(log::Level::Info));
+			chilog.info(L"HI").chan(&chan);
+			chilog.debug(L"Heya").chan(&chan);
+			chan.Flush();
+			Assert::AreEqual(L"HI"s, pDriver->entry_.note_);
+			Assert::AreEqual(1, pDriver->submitCount_.load());
+		}
+		// nothing is lost when many producers overrun a small ring
+		TEST_METHOD(TestMultipleProducers)
+		{
+			auto pDriver = std::make_shared<CountingDriver>();
+			{
+				log::AsyncChannel chan{ { pDriver }, 16 };
+				std::vector<std::future<void>> futures;
+				for (int t = 0; t < 8; t++) {
+					futures.push_back(std::async(std::launch::async, [&chan] {
+						for (int i = 0; i < 1000; i++) {
+							chilog.info(L"HI").chan(&chan);
+						}
+					}));
+				}
+				for (auto& f : futures) {
+					f.wait();
+				}
+			}
+			// destruction drains the ring
+			Assert::AreEqual(8000, pDriver->submitCount_.load());
+		}
+		// producers parked on a full ring behind a stalled driver all get through once it resumes
+		TEST_METHOD(TestParkedProducers)
+		{
+			auto pDriver = std::make_shared<GatedDriver>();
+			log::AsyncChannel chan{ { pDriver }, 4 };
+			std::vector<std::future<void>> futures;
+			for (int t = 0; t < 4; t++) {
+				futures.push_back(std::async(std::launch::async, [&chan] {
+					for (int i = 0; i < 100; i++) {
+						chilog.info(L"HI").chan(&chan);
+					}
+				}));
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+			Assert::AreEqual(0, pDriver->submitCount_.load());
+			pDriver->Open();
+			for (auto& f : futures) {
+				f.wait();
+			}
+			chan.Flush();
+			Assert::AreEqual(400, pDriver->submitCount_.load());
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/BinaryFileDriver.h>
+#include <Core/src/log/BinaryFileReader.h>
+#include <filesystem>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::string_literals;
+
+#define chilog log::EntryBuilder{ __FILEW__, __FUNCTIONW__, __LINE__ }
+
+template<> inline std::wstring __cdecl
+Microsoft::VisualStudio::CppUnitTestFramework::
+ToString<log::Level>(const log::Level& level)
+{
+	return log::GetLevelName(level);
+}
+
+namespace Log
+{
+	TEST_CLASS(LogBinaryFileTests)
+	{
+	public:
+		TEST_METHOD_INITIALIZE(Init)
+		{
+			path_ = std::filesystem::temp_directory_path() / "chil-test" / "log.bin";
+			std::filesystem::remove(path_);
+		}
+		// entries written by the driver decode back to the same fields
+		TEST_METHOD(RoundTrip)
+		{
+			{
+				log::Channel chan{ { std::make_shared<log::BinaryFileDriver>(path_) } };
+				chilog.info(L"plain note").chan(&chan);
+				chilog.warn(L"frame {} took {}us", 7, 16.5).hr(0x80004005).no_line().chan(&chan);
+				chilog.info(L"plain note").chan(&chan);
+			}
+			log::BinaryFileReader reader{ path_ };
+			log::Entry e;
+			Assert::IsTrue(reader.Next(e));
+			Assert::AreEqual(log::Level::Info, e.level_);
+			Assert::AreEqual(L"plain note"s, e.note_);
+			Assert::AreEqual(std::wstring{ __FILEW__ }, std::wstring{ e.pSite_->GetFile() });
+			Assert::IsTrue(reader.Next(e));
+			Assert::AreEqual(log::Level::Warn, e.level_);
+			Assert::IsTrue(e.deferredNote_.has_value());
+			Assert::AreEqual(L"frame 7 took 16.5us"s, e.deferredNote_->Expand());
+			Assert::AreEqual(0x80004005u, *e.hResult_);
+			Assert::IsFalse(e.showSourceLine_.value_or(true));
+			Assert::IsTrue(reader.Next(e));
+			Assert::AreEqual(L"plain note"s, e.note_);
+			Assert::IsFalse(reader.Next(e));
+		}
+		// appending a second session restarts interning without confusing the reader
+		TEST_METHOD(MultipleSessions)
+		{
+			for (int i = 0; i < 2; i++) {
+				log::Channel chan{ { std::make_shared<log::BinaryFileDriver>(path_) } };
+				chilog.info(L"session {}", i).chan(&chan);
+			}
+			log::BinaryFileReader reader{ path_ };
+			log::Entry e;
+			Assert::IsTrue(reader.Next(e));
+			Assert::AreEqual(L"session 0"s, e.deferredNote_->Expand());
+			Assert::IsTrue(reader.Next(e));
+			Assert::AreEqual(L"session 1"s, e.deferredNote_->Expand());
+			Assert::IsFalse(reader.Next(e));
+		}
+	private:
+		std::filesystem::path path_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/BufferedFileDriver.h>
+#include <Core/src/log/TextFormatter.h>
+#include <filesystem>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::chrono_literals;
+
+#define chilog log::EntryBuilder{ __FILEW__, __FUNCTIONW__, __LINE__ }
+
+namespace
+{
+	class NoteFormatter : public log::ITextFormatter
+	{
+	public:
+		void FormatTo(std::wstring& out, const log::Entry& e) const override
+		{
+			out += e.note_;
+			out += L'\n';
+		}
+	};
+}
+
+namespace Log
+{
+	TEST_CLASS(LogBufferedFileTests)
+	{
+	public:
+		TEST_METHOD_INITIALIZE(Init)
+		{
+			path_ = std::filesystem::temp_directory_path() / "chil-test" / "buffered.txt";
+			std::filesystem::remove(path_);
+		}
+		// nothing reaches the file until a rule fires or the driver is flushed
+		TEST_METHOD(CommitOnFlush)
+		{
+			auto pDriver = std::make_shared<log::BufferedFileDriver>(path_, std::make_shared<NoteFormatter>(),
+				log::BufferedFileDriver::Durability{ .commitInterval = 1h });
+			log::Channel chan{ { pDriver } };
+			chilog.info(L"one").chan(&chan);
+			chilog.info(L"two").chan(&chan);
+			Assert::AreEqual(0ull, (unsigned long long)std::filesystem::file_size(path_));
+			chan.Flush();
+			Assert::AreEqual(8ull, (unsigned long long)std::filesystem::file_size(path_));
+			const auto stats = pDriver->GetStats();
+			Assert::AreEqual(size_t(2), stats.entries);
+			Assert::AreEqual(size_t(1), stats.commits);
+			Assert::AreEqual(size_t(1), stats.syncs);
+		}
+		// severe entries are committed together with everything buffered before them
+		TEST_METHOD(CommitOnSyncLevel)
+		{
+			auto pDriver = std::make_shared<log::BufferedFileDriver>(path_, std::make_shared<NoteFormatter>(),
+				log::BufferedFileDriver::Durability{ .commitInterval = 1h, .syncLevel = log::Level::Error });
+			log::Channel chan{ { pDriver } };
+			chilog.info(L"one").chan(&chan);
+			chilog.error(L"two").no_trace().chan(&chan);
+			Assert::AreEqual(8ull, (unsigned long long)std::filesystem::file_size(path_));
+			Assert::AreEqual(size_t(1), pDriver->GetStats().syncs);
+		}
+		// the commit thread picks up buffers that pass the size threshold
+		TEST_METHOD(CommitOnSize)
+		{
+			auto pDriver = std::make_shared<log::BufferedFileDriver>(path_, std::make_shared<NoteFormatter>(),
+				log::BufferedFileDriver::Durability{ .commitBytes = 16, .commitInterval = 1h });
+			log::Channel chan{ { pDriver } };
+			for (int i = 0; i < 8; i++) {
+				chilog.info(L"entry").chan(&chan);
+			}
+			for (int i = 0; i < 100 && pDriver->GetStats().commits == 0; i++) {
+				std::this_thread::sleep_for(10ms);
+			}
+			Assert::IsTrue(pDriver->GetStats().commits > 0);
+		}
+	private:
+		std::filesystem::path path_;
+	};
+}
\ No newline at end of file
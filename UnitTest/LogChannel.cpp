@@ -3,6 +3,8 @@
 #include <Core/src/log/Channel.h>
 #include <Core/src/log/Driver.h>
 #include <Core/src/log/SeverityLevelPolicy.h>
+#include <atomic>
+#include <thread>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -22,6 +24,20 @@ public:
 	log::Entry entry_;
 };
 
+namespace
+{
+	class CountingDriver : public log::IDriver
+	{
+	public:
+		void Submit(const log::Entry&) override
+		{
+			count_.fetch_add(1, std::memory_order_relaxed);
+		}
+		void Flush() override {}
+		std::atomic<int> count_ = 0;
+	};
+}
+
 template<> inline std::wstring __cdecl
 Microsoft::VisualStudio::CppUnitTestFramework::
 ToString<log::Level>(const log::Level& level)
@@ -62,5 +78,46 @@ namespace Log
 			Assert::AreEqual(L"HI"s, pDriver1->entry_.note_);
 			Assert::AreEqual(log::Level::Info, pDriver1->entry_.level_);
 		}
+		// test level pre-check reflecting the strictest attached policy
+		TEST_METHOD(TestAcceptsLevel)
+		{
+			log::Channel chan;
+			Assert::IsTrue(chan.AcceptsLevel(log::Level::Verbose));
+			chan.AttachPolicy(std::make_unique<log::SeverityLevelPolicy>(log::Level::Info));
+			Assert::IsTrue(chan.AcceptsLevel(log::Level::Info));
+			Assert::IsFalse(chan.AcceptsLevel(log::Level::Debug));
+			chan.AttachPolicy(std::make_unique<log::SeverityLevelPolicy>(log::Level::Warn));
+			Assert::IsTrue(chan.AcceptsLevel(log::Level::Error));
+			Assert::IsFalse(chan.AcceptsLevel(log::Level::Info));
+		}
+		// test attaching drivers while other threads are submitting
+		TEST_METHOD(TestAttachWhileSubmitting)
+		{
+			log::Channel chan;
+			auto pFirst = std::make_shared<CountingDriver>();
+			chan.AttachDriver(pFirst);
+			std::atomic<bool> done = false;
+			std::vector<std::jthread> threads;
+			for (int i = 0; i < 4; i++) {
+				threads.emplace_back([&] {
+					while (!done) {
+						chilog.info(L"HI").chan(&chan);
+					}
+				});
+			}
+			std::vector<std::shared_ptr<CountingDriver>> driverPtrs;
+			for (int i = 0; i < 50; i++) {
+				driverPtrs.push_back(std::make_shared<CountingDriver>());
+				chan.AttachDriver(driverPtrs.back());
+			}
+			chilog.info(L"last").chan(&chan);
+			done = true;
+			threads.clear();
+			// every driver attached before the final entry must have seen it
+			for (auto& pDriver : driverPtrs) {
+				Assert::IsTrue(pDriver->count_ >= 1);
+			}
+			Assert::IsTrue(pFirst->count_ >= driverPtrs.back()->count_);
+		}
 	};
-}
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/CompressedFileDriver.h>
+#include <Core/src/log/CompressedFileFormat.h>
+#include <Core/src/log/CompressedFileReader.h>
+#include <Core/src/log/TextFormatter.h>
+#include <Core/src/utl/Lz.h>
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::chrono_literals;
+using namespace std::string_literals;
+
+#define chilog log::EntryBuilder{ __FILEW__, __FUNCTIONW__, __LINE__ }
+
+namespace
+{
+	class NoteFormatter : public log::ITextFormatter
+	{
+	public:
+		void FormatTo(std::wstring& out, const log::Entry& e) const override
+		{
+			out += e.note_;
+			out += L'\n';
+		}
+	};
+
+	std::string RoundTrip(const std::string& text)
+	{
+		std::string compressed;
+		utl::LzCompress(text, compressed);
+		Assert::IsTrue(compressed.size() <= utl::LzBound(text.size()));
+		std::string restored;
+		Assert::IsTrue(utl::LzDecompress(compressed, text.size(), restored));
+		return restored;
+	}
+}
+
+namespace Log
+{
+	TEST_CLASS(LogCompressedFileTests)
+	{
+	public:
+		TEST_METHOD_INITIALIZE(Init)
+		{
+			path_ = std::filesystem::temp_directory_path() / "chil-test" / "log.lz";
+			std::filesystem::remove(path_);
+			std::filesystem::remove(log::CompressedFileDriver::GetIndexPath(path_));
+		}
+		// codec restores its input for empty, incompressible, repetitive and overlapping data
+		TEST_METHOD(TestCodecRoundTrip)
+		{
+			Assert::AreEqual(""s, RoundTrip(""));
+			Assert::AreEqual("abc"s, RoundTrip("abc"));
+			std::mt19937 rng{ 42 };
+			std::string noise(5000, ' ');
+			for (auto& c : noise) {
+				c = char(rng());
+			}
+			Assert::AreEqual(noise, RoundTrip(noise));
+			const std::string run(100'000, 'x');
+			Assert::AreEqual(run, RoundTrip(run));
+			std::string lines;
+			for (int i = 0; i < 2000; i++) {
+				lines += "@Info {2026-10-17 12:00:0" + std::to_string(i % 10) + "} frame took 16ms\n";
+			}
+			std::string compressed;
+			utl::LzCompress(lines, compressed);
+			Assert::IsTrue(compressed.size() * 5 < lines.size());
+			Assert::AreEqual(lines, RoundTrip(lines));
+		}
+		// corrupt input is rejected rather than read or written out of bounds
+		TEST_METHOD(TestCodecCorrupt)
+		{
+			std::string text;
+			for (int i = 0; i < 100; i++) {
+				text += "repeat repeat repeat ";
+			}
+			std::string compressed;
+			utl::LzCompress(text, compressed);
+			std::string out;
+			Assert::IsFalse(utl::LzDecompress(compressed.substr(0, compressed.size() / 2), text.size(), out));
+			out.clear();
+			Assert::IsFalse(utl::LzDecompress(compressed, text.size() - 1, out));
+			out.clear();
+			Assert::IsFalse(utl::LzDecompress("\x0F\x01\x00", 100, out));
+		}
+		// blocks are sealed by size and read back through the index
+		TEST_METHOD(TestBlocks)
+		{
+			const auto start = std::chrono::system_clock::now();
+			{
+				auto pDriver = std::make_shared<log::CompressedFileDriver>(path_, std::make_shared<NoteFormatter>(),
+					log::CompressedFileDriver::Blocking{ .blockBytes = 1000, .sealInterval = 1h });
+				log::Channel chan{ { pDriver } };
+				for (int i = 0; i < 100; i++) {
+					chilog.info(std::format(L"entry {:03} with some repetitive padding text", i)).chan(&chan);
+				}
+				chan.Flush();
+				const auto stats = pDriver->GetStats();
+				Assert::AreEqual(size_t(100), stats.entries);
+				Assert::IsTrue(stats.blocks > 1);
+				Assert::IsTrue(stats.compressedBytes < stats.rawBytes);
+			}
+			log::CompressedFileReader reader{ path_ };
+			Assert::IsTrue(reader.IsValid());
+			std::string text;
+			for (size_t i = 0; i < reader.GetBlocks().size(); i++) {
+				Assert::IsTrue(reader.ReadBlock(i, text));
+				Assert::IsTrue(reader.GetBlocks()[i].first >= start - 1s);
+			}
+			Assert::IsTrue(text.starts_with("entry 000 "));
+			Assert::IsTrue(text.find("entry 099 ") != std::string::npos);
+			Assert::AreEqual(size_t(100), size_t(std::count(text.begin(), text.end(), '\n')));
+		}
+		// blocks missing from the index (or a missing index) are found by walking headers
+		TEST_METHOD(TestMissingIndex)
+		{
+			{
+				auto pDriver = std::make_shared<log::CompressedFileDriver>(path_, std::make_shared<NoteFormatter>(),
+					log::CompressedFileDriver::Blocking{ .blockBytes = 100, .sealInterval = 1h });
+				log::Channel chan{ { pDriver } };
+				for (int i = 0; i < 20; i++) {
+					chilog.info(L"some entry text that fills blocks").chan(&chan);
+				}
+			}
+			const auto indexed = log::CompressedFileReader{ path_ }.GetBlocks().size();
+			std::filesystem::remove(log::CompressedFileDriver::GetIndexPath(path_));
+			log::CompressedFileReader reader{ path_ };
+			Assert::AreEqual(indexed, reader.GetBlocks().size());
+			std::string text;
+			Assert::IsTrue(reader.ReadBlock(0, text));
+		}
+		// a time range selects only the blocks that overlap it
+		TEST_METHOD(TestFindBlocks)
+		{
+			const auto t0 = std::chrono::system_clock::time_point{ std::chrono::days{ 10'000 } };
+			{
+				auto pDriver = std::make_shared<log::CompressedFileDriver>(path_, std::make_shared<NoteFormatter>(),
+					log::CompressedFileDriver::Blocking{ .blockBytes = 1, .sealInterval = 1h });
+				for (int i = 0; i < 10; i++) {
+					const log::Entry e{ .note_ = L"x", .timestamp_ = log::Clock::FromSystem(t0 + std::chrono::minutes{ i }) };
+					pDriver->Submit(e);
+				}
+			}
+			log::CompressedFileReader reader{ path_ };
+			Assert::AreEqual(size_t(10), reader.GetBlocks().size());
+			const auto found = reader.FindBlocks(t0 + 150s, t0 + 5min);
+			Assert::AreEqual(size_t(3), found.size());
+			Assert::AreEqual(size_t(3), found.front());
+		}
+		// a block torn by a crash is detected by its checksum
+		TEST_METHOD(TestCorruptBlock)
+		{
+			{
+				auto pDriver = std::make_shared<log::CompressedFileDriver>(path_, std::make_shared<NoteFormatter>());
+				log::Channel chan{ { pDriver } };
+				chilog.info(L"one entry").chan(&chan);
+			}
+			{
+				std::fstream file{ path_, std::ios::in | std::ios::out | std::ios::binary };
+				file.seekp(-2, std::ios::end);
+				file.put('\x7F');
+			}
+			log::CompressedFileReader reader{ path_ };
+			Assert::AreEqual(size_t(1), reader.GetBlocks().size());
+			std::string text;
+			Assert::IsFalse(reader.ReadBlock(0, text));
+		}
+		// a torn block left by a crash is cut off when the file is reopened, so the blocks
+		// appended afterwards follow on from the last intact one
+		TEST_METHOD(TestAppendAfterTornBlock)
+		{
+			const auto write = [this](const wchar_t* note, int count) {
+				auto pDriver = std::make_shared<log::CompressedFileDriver>(path_, std::make_shared<NoteFormatter>(),
+					log::CompressedFileDriver::Blocking{ .blockBytes = 1, .sealInterval = 1h });
+				log::Channel chan{ { pDriver } };
+				for (int i = 0; i < count; i++) {
+					chilog.info(note).chan(&chan);
+				}
+			};
+			write(L"before crash", 3);
+			// tear the last block, leaving its header but only part of its data
+			const auto size = std::filesystem::file_size(path_);
+			std::filesystem::resize_file(path_, size - 2);
+			write(L"after crash", 2);
+
+			for (const bool withIndex : { true, false }) {
+				if (!withIndex) {
+					std::filesystem::remove(log::CompressedFileDriver::GetIndexPath(path_));
+				}
+				log::CompressedFileReader reader{ path_ };
+				Assert::AreEqual(size_t(4), reader.GetBlocks().size());
+				std::string text;
+				for (size_t i = 0; i < reader.GetBlocks().size(); i++) {
+					Assert::IsTrue(reader.ReadBlock(i, text));
+				}
+				Assert::AreEqual("before crash\nbefore crash\nafter crash\nafter crash\n"s, text);
+			}
+		}
+		// records missing from the end of the index are filled in when the file is reopened,
+		// so that the records appended afterwards still chain on from them
+		TEST_METHOD(TestAppendAfterLaggingIndex)
+		{
+			const auto write = [this](const wchar_t* note, int count) {
+				auto pDriver = std::make_shared<log::CompressedFileDriver>(path_, std::make_shared<NoteFormatter>(),
+					log::CompressedFileDriver::Blocking{ .blockBytes = 1, .sealInterval = 1h });
+				log::Channel chan{ { pDriver } };
+				for (int i = 0; i < count; i++) {
+					chilog.info(note).chan(&chan);
+				}
+			};
+			const auto indexPath = log::CompressedFileDriver::GetIndexPath(path_);
+			write(L"before crash", 3);
+			// lose the last index record, as if the crash came before it reached the disk
+			std::filesystem::resize_file(indexPath, std::filesystem::file_size(indexPath) - sizeof(log::compressed::IndexRecord));
+			write(L"after crash", 2);
+
+			// every block is in the index, so the reader has no blocks left to find by scanning
+			Assert::AreEqual(sizeof(log::compressed::IndexHeader) + 5 * sizeof(log::compressed::IndexRecord),
+				size_t(std::filesystem::file_size(indexPath)));
+			log::CompressedFileReader reader{ path_ };
+			Assert::AreEqual(size_t(5), reader.GetBlocks().size());
+			std::string text;
+			for (size_t i = 0; i < reader.GetBlocks().size(); i++) {
+				Assert::IsTrue(reader.ReadBlock(i, text));
+			}
+			Assert::AreEqual("before crash\nbefore crash\nbefore crash\nafter crash\nafter crash\n"s, text);
+		}
+	private:
+		std::filesystem::path path_;
+	};
+}
\ No newline at end of file
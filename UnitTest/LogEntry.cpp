@@ -52,5 +52,58 @@ namespace Log
 			Assert::AreEqual(L"HI"s, chan.entry_.note_);
 			Assert::AreEqual(log::Level::Info, chan.entry_.level_);
 		}
+		// arithmetic arguments are stored and expanded later
+		TEST_METHOD(DeferredFormatting)
+		{
+			MockChannel chan;
+			chilog.info(L"frame {} took {:.1f}us {}", 42, 16.26, true).chan(&chan);
+			Assert::IsTrue(chan.entry_.deferredNote_.has_value());
+			Assert::IsTrue(chan.entry_.note_.empty());
+			Assert::AreEqual(size_t(3), chan.entry_.deferredNote_->GetArgs().size());
+			Assert::AreEqual(L"frame 42 took 16.3us true"s, chan.entry_.deferredNote_->Expand());
+			Assert::AreEqual(log::Level::Info, chan.entry_.level_);
+		}
+		// format specs written for the original type survive normalization
+		TEST_METHOD(DeferredFormatSpecs)
+		{
+			MockChannel chan;
+			chilog.warn(L"[{:>4}] {:#x} {}", short(7), 255u, L'c').chan(&chan);
+			Assert::AreEqual(L"[   7] 0xff c"s, chan.entry_.deferredNote_->Expand());
+		}
+		// other arguments are formatted eagerly into the note
+		TEST_METHOD(EagerFormatting)
+		{
+			MockChannel chan;
+			chilog.error(L"{} {}", L"hello"s, 1).chan(&chan);
+			Assert::IsFalse(chan.entry_.deferredNote_.has_value());
+			Assert::AreEqual(L"hello 1"s, chan.entry_.note_);
+		}
+		// the last note set replaces any earlier one, wide, UTF-8 or deferred
+		TEST_METHOD(LastNoteWins)
+		{
+			MockChannel chan;
+			chilog.info(u8"utf8").note(L"wide").chan(&chan);
+			Assert::AreEqual(L"wide"s, chan.entry_.note_);
+			Assert::IsTrue(chan.entry_.noteUtf8_.empty());
+			chilog.info(L"frame {}", 1).info(u8"utf8").chan(&chan);
+			Assert::IsTrue(chan.entry_.noteUtf8_ == u8"utf8");
+			Assert::IsFalse(chan.entry_.deferredNote_.has_value());
+			chilog.info(u8"utf8").info(L"frame {}", 1).chan(&chan);
+			Assert::IsTrue(chan.entry_.noteUtf8_.empty());
+			Assert::IsTrue(chan.entry_.deferredNote_.has_value());
+		}
+		// entries are stamped on the steady clock and map to wall time and back exactly
+		TEST_METHOD(TimestampClock)
+		{
+			MockChannel chan;
+			chilog.info(L"first").chan(&chan);
+			const auto first = chan.entry_.timestamp_;
+			chilog.info(L"second").chan(&chan);
+			Assert::IsTrue(first <= chan.entry_.timestamp_);
+			const auto wall = std::chrono::system_clock::time_point{ std::chrono::days{ 10'000 } };
+			Assert::IsTrue(wall == log::Clock::ToSystem(log::Clock::FromSystem(wall)));
+			const auto drift = log::Clock::ToSystem(log::Clock::now()) - std::chrono::system_clock::now();
+			Assert::IsTrue(std::chrono::abs(drift) < std::chrono::seconds{ 1 });
+		}
 	};
-}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/FlightRecorderDriver.h>
+#include <Core/src/log/FlightRecorderReader.h>
+#include <filesystem>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::string_literals;
+
+#define chilog log::EntryBuilder{ __FILEW__, __FUNCTIONW__, __LINE__ }
+
+namespace Log
+{
+	TEST_CLASS(LogFlightRecorderTests)
+	{
+	public:
+		TEST_METHOD_INITIALIZE(Init)
+		{
+			dir_ = std::filesystem::temp_directory_path() / "chil-test" / "flight";
+			std::filesystem::remove_all(dir_);
+		}
+		// only the most recent slotCount entries are kept, and they come back in order
+		TEST_METHOD(RingKeepsMostRecent)
+		{
+			{
+				log::Channel chan{ { std::make_shared<log::FlightRecorderDriver>(dir_ / "flight.bin", 8) } };
+				for (int i = 0; i < 20; i++) {
+					chilog.info(L"entry {}", i).chan(&chan);
+				}
+			}
+			log::FlightRecorderReader reader{ dir_ / "flight.bin" };
+			Assert::IsTrue(reader.IsValid());
+			log::Entry e;
+			for (int i = 12; i < 20; i++) {
+				Assert::IsTrue(reader.Next(e));
+				Assert::AreEqual(std::format(L"entry {}", i), e.deferredNote_->Expand());
+				Assert::AreEqual(std::wstring{ __FILEW__ }, std::wstring{ e.pSite_->GetFile() });
+			}
+			Assert::IsFalse(reader.Next(e));
+			Assert::AreEqual(size_t(0), reader.GetDiscardedCount());
+		}
+		// notes too long for a slot are truncated rather than dropped
+		TEST_METHOD(LongNoteTruncated)
+		{
+			{
+				log::Channel chan{ { std::make_shared<log::FlightRecorderDriver>(dir_ / "flight.bin", 4, 256) } };
+				chilog.warn(std::wstring(1000, L'x')).hr(5).chan(&chan);
+			}
+			log::FlightRecorderReader reader{ dir_ / "flight.bin" };
+			log::Entry e;
+			Assert::IsTrue(reader.Next(e));
+			Assert::IsTrue(e.note_.size() > 0 && e.note_.size() < 256);
+			Assert::AreEqual(std::wstring(e.note_.size(), L'x'), e.note_);
+			Assert::AreEqual(5u, *e.hResult_);
+		}
+		// reopening keeps the previous run's ring next to the new one
+		TEST_METHOD(PreviousRingKept)
+		{
+			for (int run = 0; run < 2; run++) {
+				log::Channel chan{ { std::make_shared<log::FlightRecorderDriver>(dir_ / "flight.bin", 8) } };
+				chilog.info(L"run {}", run).chan(&chan);
+			}
+			log::Entry e;
+			log::FlightRecorderReader prev{ dir_ / "flight.prev.bin" };
+			Assert::IsTrue(prev.Next(e));
+			Assert::AreEqual(L"run 0"s, e.deferredNote_->Expand());
+			log::FlightRecorderReader current{ dir_ / "flight.bin" };
+			Assert::IsTrue(current.Next(e));
+			Assert::AreEqual(L"run 1"s, e.deferredNote_->Expand());
+		}
+	private:
+		std::filesystem::path dir_;
+	};
+}
\ No newline at end of file
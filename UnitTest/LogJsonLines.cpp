@@ -0,0 +1,129 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/JsonLinesDriver.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::string_literals;
+
+namespace
+{
+	class CaptureChannel : public log::IChannel
+	{
+	public:
+		void Submit(log::Entry& e) override
+		{
+			entry_ = e;
+		}
+		void AttachDriver(std::shared_ptr<log::IDriver>) override {}
+		void Flush() override {}
+		void AttachPolicy(std::shared_ptr<log::IPolicy>) override {}
+		log::Entry entry_;
+	};
+
+	const auto epoch = std::chrono::system_clock::time_point{ std::chrono::days{ 10'000 } };
+}
+
+namespace Log
+{
+	TEST_CLASS(LogJsonLinesTests)
+	{
+	public:
+		// builder stores typed fields inline in the entry
+		TEST_METHOD(TestBuilderFields)
+		{
+			CaptureChannel chan;
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::EntryBuilder{ site }.info(L"upload").field(L"bytes", 1024u).field(L"ok", true)
+				.field(L"name", L"tex.png").chan(&chan);
+			const auto& fields = chan.entry_.fields_;
+			Assert::IsTrue(fields.has_value());
+			Assert::AreEqual(size_t(3), fields->Get().size());
+			Assert::IsTrue(fields->Get()[0].key == L"bytes");
+			Assert::IsTrue(fields->Get()[0].value.kind == log::DeferredNote::Kind::Unsigned);
+			Assert::AreEqual(1024ull, fields->Get()[0].value.value.u);
+			Assert::IsTrue(fields->Get()[1].value.value.b);
+			Assert::IsTrue(fields->Get()[2].isText);
+			Assert::AreEqual(L"tex.png"s, std::wstring{ fields->GetText(fields->Get()[2]) });
+		}
+		// entries without fields carry no field storage
+		TEST_METHOD(TestNoFields)
+		{
+			CaptureChannel chan;
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::EntryBuilder{ site }.info(L"HI").chan(&chan);
+			Assert::IsFalse(chan.entry_.fields_.has_value());
+		}
+		// fields past capacity are dropped and text past the buffer is truncated
+		TEST_METHOD(TestFieldCapacity)
+		{
+			log::Fields fields;
+			for (size_t i = 0; i < log::Fields::capacity; i++) {
+				Assert::IsTrue(fields.Add(L"n", int(i)));
+			}
+			Assert::IsFalse(fields.Add(L"n", 99));
+			log::Fields text;
+			const std::wstring longText(log::Fields::textCapacity + 10, L'x');
+			Assert::IsFalse(text.Add(L"t", longText));
+			Assert::AreEqual(log::Fields::textCapacity, text.GetText(text.Get()[0]).size());
+		}
+		// one JSON object per line, with fields nested and strings escaped
+		TEST_METHOD(TestFormat)
+		{
+			const log::Site site{ L"C:\\src\\a.cpp", L"Fn", 7 };
+			log::Entry e{
+				.level_ = log::Level::Warn,
+				.note_ = L"say \"hi\"\n\u00e9",
+				.pSite_ = &site,
+				.timestamp_ = log::Clock::FromSystem(epoch + std::chrono::milliseconds{ 1500 }),
+				.hResult_ = 5u,
+			};
+			e.fields_.emplace();
+			e.fields_->Add(L"bytes", 1024);
+			e.fields_->Add(L"ms", 2.5);
+			e.fields_->Add(L"name", L"a\tb");
+			std::string line;
+			log::JsonLinesDriver::FormatTo(line, e);
+			Assert::AreEqual(
+				"{\"time\":\"1997-05-19T00:00:01.5000000Z\",\"level\":\"Warning\","
+				"\"note\":\"say \\\"hi\\\"\\n\xC3\xA9\",\"file\":\"C:\\\\src\\\\a.cpp\",\"function\":\"Fn\","
+				"\"line\":7,\"hresult\":5,\"fields\":{\"bytes\":1024,\"ms\":2.5,\"name\":\"a\\tb\"}}\n"s,
+				line
+			);
+		}
+		// deferred notes are expanded into the note member
+		TEST_METHOD(TestDeferredNote)
+		{
+			log::Entry e{ .level_ = log::Level::Info, .timestamp_ = log::Clock::FromSystem(epoch) };
+			e.deferredNote_.emplace(L"frame {}", 42);
+			std::string line;
+			log::JsonLinesDriver::FormatTo(line, e);
+			Assert::IsTrue(line.find("\"note\":\"frame 42\"") != std::string::npos);
+		}
+		// driver appends lines to its file
+		TEST_METHOD(TestDriver)
+		{
+			const auto path = std::filesystem::temp_directory_path() / "chil-test" / "log.jsonl";
+			std::filesystem::remove(path);
+			{
+				auto pDriver = std::make_shared<log::JsonLinesDriver>(path);
+				log::Channel chan{ { pDriver } };
+				const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+				log::EntryBuilder{ site }.info(L"one").field(L"n", 1).chan(&chan);
+				log::EntryBuilder{ site }.info(L"two").field(L"n", 2).chan(&chan);
+			}
+			std::ifstream file{ path, std::ios::binary };
+			std::string line;
+			int count = 0;
+			while (std::getline(file, line)) {
+				Assert::IsTrue(line.starts_with("{") && line.ends_with("}"));
+				count++;
+			}
+			Assert::AreEqual(2, count);
+		}
+	};
+}
\ No newline at end of file
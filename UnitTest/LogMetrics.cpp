@@ -0,0 +1,91 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/Driver.h>
+#include <Core/src/log/Entry.h>
+#include <Core/src/log/Metrics.h>
+#include <Core/src/log/SeverityLevelPolicy.h>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::chrono_literals;
+
+namespace
+{
+	class CountingDriver : public log::IDriver
+	{
+	public:
+		void Submit(const log::Entry&) override
+		{
+			submitted_.fetch_add(1);
+		}
+		void Flush() override {}
+		std::uint64_t GetBytesWritten() const override
+		{
+			return submitted_.load() * 10;
+		}
+	private:
+		std::atomic<std::uint64_t> submitted_ = 0;
+	};
+}
+
+namespace Log
+{
+	TEST_CLASS(LogMetricsTests)
+	{
+	public:
+		// entries are counted by level, by the policy that dropped them and by driver, from
+		// several threads at once
+		TEST_METHOD(TestChannelCounts)
+		{
+			log::Channel chan{ { std::make_shared<CountingDriver>() } };
+			chan.AttachPolicy(std::make_shared<log::SeverityLevelPolicy>(log::Level::Info));
+			{
+				std::vector<std::jthread> threads;
+				for (int t = 0; t < 4; t++) {
+					threads.emplace_back([&] {
+						for (int i = 0; i < 1000; i++) {
+							log::Entry e{ .level_ = i % 2 ? log::Level::Info : log::Level::Debug };
+							chan.Submit(e);
+						}
+					});
+				}
+			}
+			chan.Flush();
+			const auto stats = chan.GetStats();
+			Assert::AreEqual(std::uint64_t(2000), stats.submitted[size_t(log::Level::Info)]);
+			Assert::AreEqual(std::uint64_t(2000), stats.submitted[size_t(log::Level::Debug)]);
+			Assert::AreEqual(size_t(1), stats.filtered.size());
+			Assert::AreEqual(std::uint64_t(2000), stats.filtered[0]);
+			Assert::AreEqual(size_t(1), stats.drivers.size());
+			Assert::AreEqual(std::uint64_t(2000), stats.drivers[0].submit.count);
+			Assert::AreEqual(std::uint64_t(1), stats.drivers[0].flush.count);
+			Assert::AreEqual(std::uint64_t(20000), stats.drivers[0].bytesWritten);
+		}
+		// percentiles are reported as the upper edge of their power-of-two bucket
+		TEST_METHOD(TestHistogram)
+		{
+			log::LatencyHistogram histogram;
+			for (int i = 1; i <= 100; i++) {
+				histogram.Record(std::chrono::nanoseconds{ i * 10 });
+			}
+			const auto snapshot = histogram.GetSnapshot();
+			Assert::AreEqual(std::uint64_t(100), snapshot.count);
+			Assert::AreEqual(505., snapshot.GetMeanNanos());
+			Assert::AreEqual(512., snapshot.GetPercentileNanos(.5));
+			Assert::AreEqual(1024., snapshot.GetPercentileNanos(1.));
+		}
+		// the dump is one JSON object per channel
+		TEST_METHOD(TestFormatJson)
+		{
+			log::Channel chan{ { std::make_shared<CountingDriver>() } };
+			log::Entry e{ .level_ = log::Level::Warn };
+			chan.Submit(e);
+			const auto json = log::FormatStatsJson(chan.GetStats());
+			Assert::IsTrue(json.starts_with("{\"time\":"));
+			Assert::IsTrue(json.find("\"Warning\":1") != std::string::npos);
+			Assert::IsTrue(json.find("\"name\":\"CountingDriver\",\"bytes\":10,\"submit\":{\"count\":1,") != std::string::npos);
+		}
+	};
+}
\ No newline at end of file
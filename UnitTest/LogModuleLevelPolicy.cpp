@@ -0,0 +1,95 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/Entry.h>
+#include <Core/src/log/ModuleLevelPolicy.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::string_literals;
+
+namespace
+{
+	const log::Site ccrSite{ L"C:\\src\\Chil\\Core\\src\\ccr\\GenericTaskQueue.cpp", L"f", 1 };
+	const log::Site logSite{ L"C:\\src\\Chil\\Core\\src\\log\\Channel.cpp", L"f", 2 };
+	const log::Site appSite{ L"C:\\src\\Chil\\WindowApp\\App.cpp", L"f", 3 };
+	const log::Site appsSite{ L"C:\\src\\Chil\\WindowApps\\App.cpp", L"f", 4 };
+}
+
+namespace Log
+{
+	TEST_CLASS(LogModuleLevelPolicyTests)
+	{
+	public:
+		// the longest matching fragment decides, whole path components only
+		TEST_METHOD(TestLongestFragment)
+		{
+			log::ModuleLevelPolicy policy{ {
+				.defaultLevel = log::Level::Warn,
+				.rules = { { L"Core", log::Level::Info }, { L"core/src/ccr", log::Level::Verbose }, { L"WindowApp", log::Level::Error } },
+			} };
+			Assert::IsTrue(policy.GetLevel(&ccrSite) == log::Level::Verbose);
+			Assert::IsTrue(policy.GetLevel(&logSite) == log::Level::Info);
+			Assert::IsTrue(policy.GetLevel(&appSite) == log::Level::Error);
+			Assert::IsTrue(policy.GetLevel(&appsSite) == log::Level::Warn);
+			Assert::IsTrue(policy.GetLevel(nullptr) == log::Level::Warn);
+			Assert::IsTrue(policy.GetMaxLevel() == log::Level::Verbose);
+			log::Entry e{ .level_ = log::Level::Debug, .pSite_ = &ccrSite };
+			Assert::IsTrue(policy.TransformFilter(e));
+			e.pSite_ = &logSite;
+			Assert::IsFalse(policy.TransformFilter(e));
+		}
+		// levels cached per site are re-resolved when the rules change
+		TEST_METHOD(TestSetConfig)
+		{
+			log::ModuleLevelPolicy policy{ { .rules = { { L"Core/src/ccr", log::Level::Debug } } } };
+			Assert::IsTrue(policy.GetLevel(&ccrSite) == log::Level::Debug);
+			const auto version = policy.GetVersion();
+			policy.SetConfig({ .defaultLevel = log::Level::Fatal });
+			Assert::AreNotEqual(version, policy.GetVersion());
+			Assert::IsTrue(policy.GetLevel(&ccrSite) == log::Level::Fatal);
+			Assert::IsTrue(policy.GetMaxLevel() == log::Level::Fatal);
+		}
+		// config text: comments, the default and level names in any case
+		TEST_METHOD(TestParseConfig)
+		{
+			const auto config = log::ModuleLevelPolicy::ParseConfig(L"# levels\r\n* = info\r\n\r\n  Core/src/ccr = Verbose\nWindowApp=warning\n");
+			Assert::IsTrue(config.defaultLevel == log::Level::Info);
+			Assert::AreEqual(size_t(2), config.rules.size());
+			Assert::AreEqual(L"Core/src/ccr"s, config.rules[0].fragment);
+			Assert::IsTrue(config.rules[1].level == log::Level::Warn);
+			Assert::ExpectException<log::LevelConfigException>([] { log::ModuleLevelPolicy::ParseConfig(L"Core = Loud"); });
+			Assert::ExpectException<log::LevelConfigException>([] { log::ModuleLevelPolicy::ParseConfig(L"Core Verbose"); });
+		}
+		// level names parse in either spelling and any case
+		TEST_METHOD(TestParseLevelName)
+		{
+			Assert::IsTrue(log::ParseLevelName(L"Warn") == log::Level::Warn);
+			Assert::IsTrue(log::ParseLevelName(L"WARNING") == log::Level::Warn);
+			Assert::IsTrue(log::ParseLevelName(L"verbose") == log::Level::Verbose);
+			Assert::IsTrue(log::ParseLevelName(L"None") == log::Level::None);
+			Assert::IsFalse(log::ParseLevelName(L"Warnings").has_value());
+			Assert::IsFalse(log::ParseLevelName(L"").has_value());
+		}
+		// the config file is read on construction and again once it changes
+		TEST_METHOD(TestReload)
+		{
+			const auto path = std::filesystem::temp_directory_path() / "chil-test" / "levels.cfg";
+			std::filesystem::create_directories(path.parent_path());
+			std::ofstream{ path } << "Core/src/ccr = Debug\n";
+			// the watcher is kept out of the way so that the test reloads by hand
+			log::ModuleLevelPolicy policy{ path, {}, { .interval = std::chrono::hours{ 1 } } };
+			Assert::IsTrue(policy.GetLevel(&ccrSite) == log::Level::Debug);
+			Assert::IsFalse(policy.Reload());
+			std::ofstream{ path } << "* = Info\nCore/src/ccr = Verbose\n";
+			Assert::IsTrue(policy.Reload());
+			Assert::IsTrue(policy.GetLevel(&ccrSite) == log::Level::Verbose);
+			Assert::IsTrue(policy.GetLevel(&appSite) == log::Level::Info);
+			// a bad file leaves the rules as they were
+			std::ofstream{ path } << "Core/src/ccr = Noisy\n";
+			Assert::ExpectException<log::LevelConfigException>([&] { policy.Reload(); });
+			Assert::IsTrue(policy.GetLevel(&ccrSite) == log::Level::Verbose);
+		}
+	};
+}
\ No newline at end of file
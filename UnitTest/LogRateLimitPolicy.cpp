@@ -0,0 +1,191 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/ioc/Container.h>
+#include <Core/src/log/Entry.h>
+#include <Core/src/log/FlightRecorderDriver.h>
+#include <Core/src/log/Log.h>
+#include <Core/src/log/MsvcDebugDriver.h>
+#include <Core/src/log/RateLimitPolicy.h>
+#include <Core/src/log/RotatingFileDriver.h>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::string_literals;
+using namespace std::chrono_literals;
+
+namespace
+{
+	const auto start = log::Clock::time_point{} + 1000h;
+
+	log::Entry MakeEntry(const log::Site& site, log::Clock::duration offset)
+	{
+		return log::Entry{
+			.level_ = log::Level::Error,
+			.note_ = L"HI",
+			.pSite_ = &site,
+			.timestamp_ = start + offset,
+		};
+	}
+
+	// stands in for one of the drivers of the booted channel, counting error entries
+	template<class I>
+	class CountingDriver : public I
+	{
+	public:
+		CountingDriver(std::shared_ptr<int> pCount) : pCount_{ std::move(pCount) } {}
+		void Submit(const log::Entry& e) override
+		{
+			*pCount_ += e.level_ == log::Level::Error;
+		}
+		void Flush() override {}
+		void SetFormatter(std::shared_ptr<log::ITextFormatter>) {}
+	private:
+		std::shared_ptr<int> pCount_;
+	};
+}
+
+namespace Log
+{
+	TEST_CLASS(LogRateLimitPolicyTests)
+	{
+	public:
+		// a site may emit its burst at once, after which entries are dropped
+		TEST_METHOD(TestBurst)
+		{
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::RateLimitPolicy policy{ { .rate = 1., .burst = 3 } };
+			int passed = 0;
+			for (int i = 0; i < 10; i++) {
+				auto e = MakeEntry(site, 0s);
+				passed += policy.TransformFilter(e);
+			}
+			Assert::AreEqual(3, passed);
+			Assert::AreEqual(size_t(7), policy.GetSuppressedCount());
+		}
+		// once the bucket refills, the next entry carries the number dropped in between
+		TEST_METHOD(TestSuppressedAnnotation)
+		{
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::RateLimitPolicy policy{ { .rate = 1., .burst = 1 } };
+			auto first = MakeEntry(site, 0s);
+			Assert::IsTrue(policy.TransformFilter(first));
+			Assert::AreEqual(L"HI"s, first.note_);
+			for (int i = 0; i < 4; i++) {
+				auto e = MakeEntry(site, 100ms * i);
+				Assert::IsFalse(policy.TransformFilter(e));
+			}
+			auto later = MakeEntry(site, 2s);
+			Assert::IsTrue(policy.TransformFilter(later));
+			Assert::AreEqual(L"HI [suppressed 4 similar messages]"s, later.note_);
+			// the count is reset once reported
+			auto next = MakeEntry(site, 4s);
+			Assert::IsTrue(policy.TransformFilter(next));
+			Assert::AreEqual(L"HI"s, next.note_);
+		}
+		// deferred notes are expanded so that the annotation can be appended
+		TEST_METHOD(TestSuppressedAnnotationDeferred)
+		{
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::RateLimitPolicy policy{ { .rate = 1., .burst = 1 } };
+			auto first = MakeEntry(site, 0s);
+			policy.TransformFilter(first);
+			auto dropped = MakeEntry(site, 0s);
+			policy.TransformFilter(dropped);
+			auto later = MakeEntry(site, 2s);
+			later.deferredNote_.emplace(L"frame {}", 42);
+			Assert::IsTrue(policy.TransformFilter(later));
+			Assert::IsFalse(later.deferredNote_.has_value());
+			Assert::AreEqual(L"frame 42 [suppressed 1 similar messages]"s, later.note_);
+		}
+		// drops not yet reported by an admitted entry are handed over as an entry of their own
+		TEST_METHOD(TestPendingSummary)
+		{
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::RateLimitPolicy policy{ { .rate = 1., .burst = 1 } };
+			for (int i = 0; i < 5; i++) {
+				auto e = MakeEntry(site, 0s);
+				e.level_ = log::Level::Warn;
+				policy.TransformFilter(e);
+			}
+			std::vector<log::Entry> pending;
+			policy.TakePending(pending);
+			Assert::AreEqual(size_t(1), pending.size());
+			Assert::AreEqual(L"[suppressed 4 similar messages]"s, pending[0].note_);
+			Assert::IsTrue(pending[0].level_ == log::Level::Warn);
+			Assert::IsTrue(pending[0].pSite_ == &site);
+			// reported once only, here or on the next admitted entry
+			pending.clear();
+			policy.TakePending(pending);
+			Assert::AreEqual(size_t(0), pending.size());
+			auto later = MakeEntry(site, 2s);
+			Assert::IsTrue(policy.TransformFilter(later));
+			Assert::AreEqual(L"HI"s, later.note_);
+		}
+		// levels at or above the exempt level are never limited
+		TEST_METHOD(TestExemptLevel)
+		{
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::RateLimitPolicy policy{ { .rate = 1., .burst = 1, .exemptLevel = log::Level::Error } };
+			for (int i = 0; i < 5; i++) {
+				auto e = MakeEntry(site, 0s);
+				Assert::IsTrue(policy.TransformFilter(e));
+			}
+			auto warn = MakeEntry(site, 0s);
+			warn.level_ = log::Level::Warn;
+			Assert::IsTrue(policy.TransformFilter(warn));
+			warn = MakeEntry(site, 0s);
+			warn.level_ = log::Level::Warn;
+			Assert::IsFalse(policy.TransformFilter(warn));
+		}
+		// each site has its own bucket
+		TEST_METHOD(TestSitesIndependent)
+		{
+			const log::Site siteA{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			const log::Site siteB{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::RateLimitPolicy policy{ { .rate = 1., .burst = 1 } };
+			auto a1 = MakeEntry(siteA, 0s);
+			auto a2 = MakeEntry(siteA, 0s);
+			auto b1 = MakeEntry(siteB, 0s);
+			Assert::IsTrue(policy.TransformFilter(a1));
+			Assert::IsFalse(policy.TransformFilter(a2));
+			Assert::IsTrue(policy.TransformFilter(b1));
+		}
+		// sites that do not fit in the table pass through unlimited
+		TEST_METHOD(TestTableFull)
+		{
+			const log::Site siteA{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			const log::Site siteB{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::RateLimitPolicy policy{ { .rate = 1., .burst = 1, .capacity = 1 } };
+			auto a = MakeEntry(siteA, 0s);
+			policy.TransformFilter(a);
+			for (int i = 0; i < 5; i++) {
+				auto b = MakeEntry(siteB, 0s);
+				Assert::IsTrue(policy.TransformFilter(b));
+			}
+		}
+		// the default channel limits an error site hit every frame, reporting the drops on flush
+		TEST_METHOD(TestBootedChannelLimitsErrors)
+		{
+			log::Boot();
+			auto pCount = std::make_shared<int>(0);
+			ioc::Get().Register<log::IMsvcDebugDriver>([=] {
+				return std::make_shared<CountingDriver<log::IMsvcDebugDriver>>(pCount);
+			});
+			ioc::Get().Register<log::IRotatingFileDriver>([=] {
+				return std::make_shared<CountingDriver<log::IRotatingFileDriver>>(std::make_shared<int>());
+			});
+			ioc::Get().Register<log::IFlightRecorderDriver>([=] {
+				return std::make_shared<CountingDriver<log::IFlightRecorderDriver>>(std::make_shared<int>());
+			});
+			const auto pChan = ioc::Get().Resolve<log::IChannel>();
+			for (int frame = 0; frame < 200; frame++) {
+				log::EntryBuilder{ ZZ_LOG_SITE_(log::Level::Error) }.chan(pChan.get()).error(L"every frame");
+			}
+			const auto emitted = *pCount;
+			Assert::IsTrue(emitted > 0 && emitted < 100);
+			pChan->Flush();
+			Assert::AreEqual(emitted + 1, *pCount);
+		}
+	};
+}
\ No newline at end of file
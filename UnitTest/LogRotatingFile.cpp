@@ -0,0 +1,74 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/RotatingFileDriver.h>
+#include <Core/src/log/TextFormatter.h>
+#include <filesystem>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+
+#define chilog log::EntryBuilder{ __FILEW__, __FUNCTIONW__, __LINE__ }
+
+namespace
+{
+	class NoteFormatter : public log::ITextFormatter
+	{
+	public:
+		void FormatTo(std::wstring& out, const log::Entry& e) const override
+		{
+			out += e.note_;
+			out += L'\n';
+		}
+	};
+}
+
+namespace Log
+{
+	TEST_CLASS(LogRotatingFileTests)
+	{
+	public:
+		TEST_METHOD_INITIALIZE(Init)
+		{
+			dir_ = std::filesystem::temp_directory_path() / "chil-test" / "rotating";
+			std::filesystem::remove_all(dir_);
+		}
+		// archive names keep the extension of the active file
+		TEST_METHOD(ArchiveNaming)
+		{
+			log::RotatingFileDriver driver{ dir_ / "log.txt" };
+			Assert::IsTrue(dir_ / "log.3.txt" == driver.GetArchivePath(3));
+		}
+		// segments roll over by size and only maxArchives archives are kept
+		TEST_METHOD(RotateBySize)
+		{
+			auto pDriver = std::make_shared<log::RotatingFileDriver>(dir_ / "log.txt", std::make_shared<NoteFormatter>(),
+				log::RotatingFileDriver::Rotation{ .segmentBytes = 20, .maxArchives = 2 });
+			log::Channel chan{ { pDriver } };
+			// flushing after each entry makes every entry its own write batch
+			for (int i = 0; i < 10; i++) {
+				chilog.info(L"entry-" + std::to_wstring(i)).chan(&chan);
+				chan.Flush();
+			}
+			// 8 bytes per entry, two per 20 byte segment
+			Assert::AreEqual(size_t(4), pDriver->GetStats().rotations);
+			Assert::AreEqual(16ull, (unsigned long long)std::filesystem::file_size(dir_ / "log.txt"));
+			Assert::IsTrue(std::filesystem::exists(pDriver->GetArchivePath(1)));
+			Assert::IsTrue(std::filesystem::exists(pDriver->GetArchivePath(2)));
+			Assert::IsFalse(std::filesystem::exists(pDriver->GetArchivePath(3)));
+		}
+		// an existing active file is continued rather than truncated
+		TEST_METHOD(AppendToExisting)
+		{
+			for (int i = 0; i < 2; i++) {
+				auto pDriver = std::make_shared<log::RotatingFileDriver>(dir_ / "log.txt", std::make_shared<NoteFormatter>());
+				log::Channel chan{ { pDriver } };
+				chilog.info(L"entry-0").chan(&chan);
+			}
+			Assert::AreEqual(16ull, (unsigned long long)std::filesystem::file_size(dir_ / "log.txt"));
+		}
+	private:
+		std::filesystem::path dir_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/log/Site.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::string_literals;
+
+namespace
+{
+	class CountingChannel : public log::IChannel
+	{
+	public:
+		void Submit(log::Entry&) override
+		{
+			count_++;
+		}
+		void AttachDriver(std::shared_ptr<log::IDriver>) override {}
+		void Flush() override {}
+		void AttachPolicy(std::shared_ptr<log::IPolicy>) override {}
+		int count_ = 0;
+	};
+}
+
+static const log::Site& EmitSite()
+{
+	return ZZ_LOG_SITE_(log::Level::Warn);
+}
+
+namespace Log
+{
+	TEST_CLASS(LogSiteTests)
+	{
+	public:
+		// a macro-emitted site is created once and carries its location
+		TEST_METHOD(StaticSiteIdentity)
+		{
+			const auto& site = EmitSite();
+			Assert::IsTrue(&site == &EmitSite());
+			Assert::AreEqual(L"EmitSite"s, std::wstring{ site.GetFunction() });
+			Assert::AreEqual(29, site.GetLine());
+			Assert::IsTrue(site.GetLevel() == log::Level::Warn);
+		}
+		// reached sites show up in the registry
+		TEST_METHOD(RegistryEnumeration)
+		{
+			const auto& site = EmitSite();
+			bool found = false;
+			log::ForEachSite([&](log::StaticSite& s) {
+				found = found || &s == &site;
+			});
+			Assert::IsTrue(found);
+		}
+		// disabling a site by file and line drops its entries
+		TEST_METHOD(ToggleSite)
+		{
+			CountingChannel chan;
+			const auto& site = EmitSite();
+			log::EntryBuilder{ site }.no_trace().chan(&chan);
+			Assert::AreEqual(1, chan.count_);
+			Assert::AreEqual(size_t(1), log::SetSitesEnabled(L"LogSite.cpp", 29, false));
+			Assert::IsFalse(site.IsEnabled());
+			log::EntryBuilder{ site }.no_trace().chan(&chan);
+			Assert::AreEqual(1, chan.count_);
+			log::SetSitesEnabled(L"LogSite.cpp", 29, true);
+			log::EntryBuilder{ site }.no_trace().chan(&chan);
+			Assert::AreEqual(2, chan.count_);
+		}
+		// dynamic locations are interned to one site per location
+		TEST_METHOD(InternedSite)
+		{
+			const std::wstring file = L"dynamic.cpp";
+			const auto& a = log::InternSite(file.c_str(), L"Fn", 7);
+			const auto& b = log::InternSite(L"dynamic.cpp", L"Fn", 7);
+			const auto& c = log::InternSite(L"dynamic.cpp", L"Fn", 8);
+			Assert::IsTrue(&a == &b);
+			Assert::IsTrue(&a != &c);
+			Assert::AreEqual(L"dynamic.cpp"s, std::wstring{ a.GetFile() });
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/StagedChannel.h>
+#include <Core/src/log/Driver.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::string_literals;
+
+// a function-local static site per call, as Log.h's chilog has, so that producers do not
+// serialize on the InternSite lookup
+#define chilog log::EntryBuilder{ ZZ_LOG_SITE_(log::Level::Error) }
+
+namespace
+{
+	// only ever called from the collector thread, and read after a flush
+	class RecordingDriver : public log::IDriver
+	{
+	public:
+		void Submit(const log::Entry& e) override
+		{
+			notes_.push_back(e.note_);
+			timestamps_.push_back(e.timestamp_);
+		}
+		void Flush() override {}
+		std::vector<std::wstring> notes_;
+		std::vector<log::Clock::time_point> timestamps_;
+	};
+}
+
+namespace Log
+{
+	TEST_CLASS(LogStagedChannelTests)
+	{
+	public:
+		// entries reach the driver once the channel is flushed, hold-back notwithstanding
+		TEST_METHOD(TestForwardingAfterFlush)
+		{
+			auto pDriver = std::make_shared<RecordingDriver>();
+			log::StagedChannel chan{ { pDriver }, { .holdback = std::chrono::milliseconds{ 10'000 } } };
+			chilog.info(L"HI").chan(&chan);
+			chan.Flush();
+			Assert::AreEqual(size_t(1), pDriver->notes_.size());
+			Assert::AreEqual(L"HI"s, pDriver->notes_[0]);
+		}
+		// entries from several producers come out complete and ordered by timestamp, also
+		// when small buffers make producers wait on the collector
+		TEST_METHOD(TestMergedInOrder)
+		{
+			auto pDriver = std::make_shared<RecordingDriver>();
+			log::StagedChannel chan{ { pDriver }, { .capacity = 64, .holdback = std::chrono::milliseconds{ 50 } } };
+			std::vector<std::jthread> threads;
+			for (int t = 0; t < 4; t++) {
+				threads.emplace_back([&chan] {
+					for (int i = 0; i < 2000; i++) {
+						chilog.info(L"HI").no_trace().chan(&chan);
+					}
+				});
+			}
+			threads.clear();
+			chan.Flush();
+			Assert::AreEqual(size_t(8000), pDriver->timestamps_.size());
+			Assert::IsTrue(std::ranges::is_sorted(pDriver->timestamps_));
+		}
+		// entries staged by a thread that has since exited are not lost
+		TEST_METHOD(TestExitedProducer)
+		{
+			auto pDriver = std::make_shared<RecordingDriver>();
+			{
+				log::StagedChannel chan{ { pDriver } };
+				std::jthread{ [&chan] { chilog.info(L"first").chan(&chan); } }.join();
+				chan.Flush();
+				std::jthread{ [&chan] { chilog.info(L"second").chan(&chan); } }.join();
+			}
+			Assert::AreEqual(size_t(2), pDriver->notes_.size());
+			Assert::AreEqual(L"second"s, pDriver->notes_[1]);
+		}
+	};
+}
\ No newline at end of file
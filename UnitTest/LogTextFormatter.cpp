@@ -1,6 +1,10 @@
 #include "ChilCppUnitTest.h"
 #include <Core/src/log/Entry.h>
 #include <Core/src/log/TextFormatter.h>
+#include <Core/src/log/EntryBuilder.h>
+#include <Core/src/log/Channel.h>
+#include <Core/src/utl/String.h>
+#include <format>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -15,20 +19,101 @@ namespace Log
 		// testing text formatting
 		TEST_METHOD(TestFormat)
 		{
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
 			const log::Entry e{
 				.level_ = log::Level::Info,
 				.note_ = L"Heya",
-				.sourceFile_ = __FILEW__,
-				.sourceFunctionName_ = __FUNCTIONW__,
-				.sourceLine_ = __LINE__,
-				.timestamp_ = std::chrono::system_clock::time_point{
+				.pSite_ = &site,
+				.timestamp_ = log::Clock::FromSystem(std::chrono::system_clock::time_point{
 					std::chrono::days{ 10'000 }
-				}
+				})
 			};
 			Assert::AreEqual(
-				L"@Info {1997-05-19 09:00:00.0000000 GMT+9} Heya\n  >> at Log::LogTextFormatterTests::TestFormat\n     C:\\Users\\Chili\\Desktop\\cpp\\Chil\\UnitTest\\LogTextFormatter.cpp(23)\n"s,
+				L"@Info {1997-05-19 09:00:00.0000000 GMT+9} Heya\n  >> at Log::LogTextFormatterTests::TestFormat\n     C:\\Users\\Chili\\Desktop\\cpp\\Chil\\UnitTest\\LogTextFormatter.cpp(22)\n"s,
 				log::TextFormatter{}.Format(e)
 			);
 		}
+		// cached date/time prefix must track the timestamp across second boundaries
+		TEST_METHOD(TestTimestampCache)
+		{
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::Entry e{
+				.level_ = log::Level::Info,
+				.note_ = L"Heya",
+				.pSite_ = &site,
+				.showSourceLine_ = false,
+			};
+			const log::TextFormatter formatter;
+			const auto start = std::chrono::system_clock::time_point{ std::chrono::days{ 10'000 } };
+			std::wstring buffer;
+			for (auto offset : { 0, 300, 999, 1000, 1700, 61'000 }) {
+				e.timestamp_ = log::Clock::FromSystem(start + std::chrono::milliseconds{ offset });
+				const auto expected = std::format(L"@Info {{{}}} Heya\n",
+					std::chrono::zoned_time{ std::chrono::current_zone(), start + std::chrono::milliseconds{ offset } });
+				buffer.clear();
+				formatter.FormatTo(buffer, e);
+				Assert::AreEqual(expected, buffer);
+			}
+			// appends rather than overwriting
+			formatter.FormatTo(buffer, e);
+			Assert::AreEqual(buffer.size() % 2, size_t(0));
+			Assert::AreEqual(buffer.substr(0, buffer.size() / 2), buffer.substr(buffer.size() / 2));
+		}
+		// structured fields follow the note
+		TEST_METHOD(TestFields)
+		{
+			log::Entry e{
+				.level_ = log::Level::Info,
+				.note_ = L"upload",
+				.timestamp_ = log::Clock::FromSystem(std::chrono::system_clock::time_point{ std::chrono::days{ 10'000 } }),
+			};
+			e.fields_.emplace();
+			e.fields_->Add(L"bytes", 1024);
+			e.fields_->Add(L"ms", 2.5);
+			e.fields_->Add(L"name", L"tex.png");
+			const auto text = log::TextFormatter{}.Format(e);
+			Assert::IsTrue(text.ends_with(L"} upload (bytes=1024, ms=2.5, name=tex.png)\n"));
+		}
+		// UTF-8 output matches the wide output transcoded, whichever form the note takes
+		TEST_METHOD(TestFormatUtf8)
+		{
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::Entry e{
+				.level_ = log::Level::Warn,
+				.note_ = L"caf\u00e9 \U0001F600",
+				.pSite_ = &site,
+				.timestamp_ = log::Clock::FromSystem(std::chrono::system_clock::time_point{ std::chrono::days{ 10'000 } }),
+				.hResult_ = 0x80004005u,
+			};
+			e.fields_.emplace();
+			e.fields_->Add(L"ms", 2.5);
+			e.fields_->Add(L"c", L'\u00e9');
+			const log::TextFormatter formatter;
+			const auto wide = formatter.Format(e);
+			Assert::AreEqual(utl::ToUtf8(wide), formatter.FormatUtf8(e));
+			// a UTF-8 note takes the place of the wide one and is copied through unchanged
+			e.note_.clear();
+			e.noteUtf8_ = u8"caf\u00e9 \U0001F600";
+			Assert::AreEqual(utl::ToUtf8(wide), formatter.FormatUtf8(e));
+			Assert::AreEqual(wide, formatter.Format(e));
+		}
+		// builder overloads store UTF-8 notes without converting them
+		TEST_METHOD(TestBuilderUtf8)
+		{
+			class CaptureChannel : public log::IChannel
+			{
+			public:
+				void Submit(log::Entry& e) override { entry_ = e; }
+				void Flush() override {}
+				void AttachDriver(std::shared_ptr<log::IDriver>) override {}
+				void AttachPolicy(std::shared_ptr<log::IPolicy>) override {}
+				log::Entry entry_;
+			} chan;
+			const log::Site site{ __FILEW__, __FUNCTIONW__, __LINE__ };
+			log::EntryBuilder{ site }.warn(u8"\u00fcber").chan(&chan);
+			Assert::IsTrue(chan.entry_.level_ == log::Level::Warn);
+			Assert::IsTrue(chan.entry_.noteUtf8_ == u8"\u00fcber");
+			Assert::IsTrue(chan.entry_.note_.empty());
+		}
 	};
-}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "ChilCppUnitTest.h"
+#include <Core/src/log/SimpleFileDriver.h>
+#include <Core/src/log/TextFormatter.h>
+#include <Core/src/log/TextLogIndex.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace chil;
+using namespace std::chrono_literals;
+
+namespace
+{
+	const log::Site appSite{ L"C:\\src\\App.cpp", L"App::Run", 10 };
+	const log::Site otherSite{ L"C:\\src\\MyApp.cpp", L"MyApp::Run", 20 };
+	const std::chrono::system_clock::time_point t0{ std::chrono::days{ 20'000 } };
+
+	void Write(const std::filesystem::path& path, log::Level level, const log::Site& site, std::chrono::seconds offset)
+	{
+		log::SimpleFileDriver driver{ path, std::make_shared<log::TextFormatter>() };
+		driver.Submit({ .level_ = level, .note_ = L"note\n@not a header", .pSite_ = &site, .timestamp_ = log::Clock::FromSystem(t0 + offset) });
+	}
+	utl::LocalTime ToLocal(std::chrono::system_clock::time_point time)
+	{
+		return std::chrono::zoned_time{ std::chrono::current_zone(), time }.get_local_time();
+	}
+}
+
+namespace Log
+{
+	TEST_CLASS(LogTextLogIndexTests)
+	{
+	public:
+		TEST_METHOD_INITIALIZE(Init)
+		{
+			path_ = std::filesystem::temp_directory_path() / "chil-test" / "indexed.txt";
+			std::filesystem::remove(path_);
+			std::filesystem::remove(log::TextLogIndex::GetIndexPath(path_));
+		}
+		// queries combine level, source file and time range
+		TEST_METHOD(TestQuery)
+		{
+			Write(path_, log::Level::Info, appSite, 0s);
+			Write(path_, log::Level::Error, appSite, 1s);
+			Write(path_, log::Level::Fatal, otherSite, 2s);
+			Write(path_, log::Level::Error, appSite, 3s);
+			log::TextLogIndex index{ path_ };
+			Assert::IsTrue(index.Update());
+			Assert::AreEqual(size_t(4), index.GetRecords().size());
+
+			const auto matches = index.Find({
+				.from = ToLocal(t0 + 1s),
+				.to = ToLocal(t0 + 2s),
+				.level = log::Level::Error,
+				.file = "app.cpp",
+			});
+			Assert::AreEqual(size_t(1), matches.size());
+			const auto& record = index.GetRecords()[matches[0]];
+			Assert::AreEqual(10, record.line);
+			Assert::AreEqual(std::string_view{ "C:\\src\\App.cpp" }, index.GetFile(record));
+			Assert::IsTrue(index.GetText(record).starts_with("@Error {"));
+			Assert::IsTrue(index.GetText(record).ends_with("App.cpp(10)\n"));
+			// errors and worse from any file
+			Assert::AreEqual(size_t(3), index.Find({ .level = log::Level::Error }).size());
+		}
+		// a reopened index resumes from the sidecar and only scans what was appended
+		TEST_METHOD(TestIncremental)
+		{
+			Write(path_, log::Level::Info, appSite, 0s);
+			Write(path_, log::Level::Info, appSite, 1s);
+			{
+				log::TextLogIndex index{ path_ };
+				Assert::IsTrue(index.Update());
+				// the last entry may still be growing, so it is not persisted yet
+				Assert::AreEqual(size_t(1), index.GetPersistedCount());
+			}
+			Write(path_, log::Level::Warn, otherSite, 2s);
+			log::TextLogIndex index{ path_ };
+			Assert::AreEqual(size_t(1), index.GetRecords().size());
+			Assert::IsTrue(index.Update());
+			Assert::AreEqual(size_t(3), index.GetRecords().size());
+			Assert::AreEqual(size_t(2), index.GetPersistedCount());
+			Assert::AreEqual(size_t(1), index.Find({ .file = "MyApp.cpp", .line = 20 }).size());
+		}
+		// a log replaced by a new one (after rotation) gets a fresh index
+		TEST_METHOD(TestReplaced)
+		{
+			Write(path_, log::Level::Info, appSite, 0s);
+			Write(path_, log::Level::Info, appSite, 1s);
+			Write(path_, log::Level::Info, appSite, 2s);
+			log::TextLogIndex{ path_ }.Update();
+			std::filesystem::remove(path_);
+			Write(path_, log::Level::Error, otherSite, 5s);
+			log::TextLogIndex index{ path_ };
+			Assert::IsTrue(index.GetRecords().empty());
+			Assert::IsTrue(index.Update());
+			Assert::AreEqual(size_t(1), index.GetRecords().size());
+			Assert::AreEqual(20, index.GetRecords()[0].line);
+		}
+	private:
+		std::filesystem::path path_;
+	};
+}
\ No newline at end of file
@@ -20,8 +20,8 @@ namespace chil::app
 	void operator>>(HrGrabber g, CheckerToken)
 	{
 		if (FAILED(g.hr)) {
-			// get error description as narrow string with crlf removed
-			auto errorString = utl::ToNarrow(win::GetErrorDescription(g.hr)) |
+			// get error description as UTF-8 string with crlf removed
+			auto errorString = utl::ToUtf8(win::GetErrorDescription(g.hr)) |
 				vi::transform([](char c) {return c == '\n' ? ' ' : c; }) |
 				vi::filter([](char c) {return c != '\r'; }) |
 				rn::to<std::basic_string>();
@@ -1,8 +1,12 @@
 #include <Core/src/win/IWindow.h>
 #include <Core/src/log/Log.h>
 #include <Core/src/ioc/Container.h>
-#include <Core/src/log/SeverityLevelPolicy.h>
+#include <Core/src/log/ModuleLevelPolicy.h>
+#include <Core/src/log/Metrics.h>
+#include <Core/src/ioc/Singletons.h>
 #include <Core/src/win/Boot.h>
+#include <Core/src/win/Utilities.h>
+#include <Core/src/utl/Exception.h>
 #include "App.h"
 
 using namespace chil;
@@ -11,8 +15,11 @@ using namespace std::string_literals;
 void Boot()
 {
 	log::Boot();
-	ioc::Get().Register<log::ISeverityLevelPolicy>([] {
-		return std::make_shared<log::SeverityLevelPolicy>(log::Level::Info);
+	// Info everywhere unless log-levels.cfg next to the executable (re-read while running)
+	// says otherwise
+	ioc::Get().Register<log::IModuleLevelPolicy>([] {
+		return std::make_shared<log::ModuleLevelPolicy>(win::GetExecutableDirectory() / L"log-levels.cfg",
+			log::ModuleLevelPolicy::Config{ .defaultLevel = log::Level::Info });
 	});
 
 	win::Boot();
@@ -26,12 +33,15 @@ int WINAPI wWinMain(
 {
 	try {
 		Boot();
+		// logging pipeline counters, appended as a JSON line every 10 seconds
+		const log::StatsDumper statsDumper{ ioc::Sing().Resolve<log::IChannel>(), "logs\\stats.jsonl" };
 		auto pWindow = ioc::Get().Resolve<win::IWindow>();
 		return app::Run(*pWindow);
 	}
 	catch (const std::exception& e) {
-		chilog.error(utl::ToWide(e.what())).no_line().no_trace();
-		MessageBoxA(nullptr, e.what(), "Error", MB_ICONERROR | MB_SETFOREGROUND);
+		const auto message = utl::DescribeException(e);
+		chilog.error(message).no_line().no_trace();
+		MessageBoxW(nullptr, message.c_str(), L"Error", MB_ICONERROR | MB_SETFOREGROUND);
 	}
 	return -1;
 }
\ No newline at end of file